@@ -0,0 +1,45 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+// FIFO between two pipeline stages.
+// Push blocks while 'capacity' items are waiting, so a producer can not run ahead
+// of its consumer, Pop blocks while the queue is empty and fails once it is closed
+// and drained.
+template <typename T> class BoundedQueue {
+private:
+  std::mutex lock;
+  std::condition_variable notFull;
+  std::condition_variable notEmpty;
+  std::deque<T> items;
+  size_t capacity;
+  bool closed = false;
+
+public:
+  explicit BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+  void Push(T item) {
+    std::unique_lock<std::mutex> guard(lock);
+    notFull.wait(guard, [this] { return items.size() < capacity; });
+    items.push_back(std::move(item));
+    notEmpty.notify_one();
+  }
+
+  bool Pop(T& item) {
+    std::unique_lock<std::mutex> guard(lock);
+    notEmpty.wait(guard, [this] { return items.size() || closed; });
+    if (items.empty()) return false;
+    item = std::move(items.front());
+    items.pop_front();
+    notFull.notify_one();
+    return true;
+  }
+
+  // No more items will be pushed
+  void Close() {
+    std::lock_guard<std::mutex> guard(lock);
+    closed = true;
+    notEmpty.notify_all();
+  }
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include "defs.h"
+
+// Append-only array whose elements never move, for tables that many threads read
+// while one of them appends. Appends have to be serialized by the owner, reading an
+// element that was already appended needs no lock. Chunk k holds 2^(k + FirstBits)
+// elements, so a few chunk pointers cover every uint32 index.
+template <typename T, uint32 FirstBits = 10> class ChunkedArray {
+private:
+  static constexpr uint32 Chunks = 33 - FirstBits;
+
+  std::atomic<T*> chunks[Chunks] = {};
+  std::atomic<uint32> count = 0;
+
+  static void Locate(uint32 index, uint32& chunk, uint32& offset) {
+    uint64 shifted = (uint64)index + (1ull << FirstBits);
+    chunk = (uint32)std::bit_width(shifted) - 1 - FirstBits;
+    offset = (uint32)(shifted - (1ull << (chunk + FirstBits)));
+  }
+
+public:
+  ChunkedArray(std::initializer_list<T> items) {
+    for (auto& item : items) PushBack(item);
+  }
+  ~ChunkedArray() {
+    for (auto& chunk : chunks) delete[] chunk.load();
+  }
+  ChunkedArray(const ChunkedArray&) = delete;
+  ChunkedArray& operator=(const ChunkedArray&) = delete;
+
+  uint32 Size() const { return count.load(std::memory_order_acquire); }
+
+  const T& operator[](uint32 index) const {
+    uint32 chunk, offset;
+    Locate(index, chunk, offset);
+    return chunks[chunk].load(std::memory_order_acquire)[offset];
+  }
+
+  // Returns the index of the new element, only one thread may append at a time
+  uint32 PushBack(T item) {
+    auto index = count.load(std::memory_order_relaxed);
+    uint32 chunk, offset;
+    Locate(index, chunk, offset);
+    auto data = chunks[chunk].load(std::memory_order_relaxed);
+    if (!data) {
+      data = new T[1ull << (chunk + FirstBits)];
+      chunks[chunk].store(data, std::memory_order_release);
+    }
+    data[offset] = std::move(item);
+    count.store(index + 1, std::memory_order_release);
+    return index;
+  }
+};
@@ -1,4 +1,56 @@
+#include <climits>
 #include "ClassSizeFixer.h"
+#include "DumpScope.h"
+#include "PropertyChain.h"
+#include "TaskPool.h"
 
+std::vector<int32> ClassSizeFixer::sizes;
 
-std::unordered_map<void*, int> ClassSizeFixer::sizeMp;
\ No newline at end of file
+int ClassSizeFixer::FixAllPackage(std::vector<UE_UPackage>& packages) {
+  auto classClass = ObjTable.IndexOf(UE_UClass::StaticClass());
+  auto scriptStructClass = ObjTable.IndexOf(UE_UScriptStruct::StaticClass());
+
+  std::vector<int32> structs;
+  for (auto& package : packages) {
+    for (auto& object : package.Package->second) {
+      auto index = ObjTable.IndexOf(object);
+      // only declared, its size is never written
+      if (DumpScope::IsDeclared(index)) continue;
+      if (ObjTable.IsA(index, classClass) || ObjTable.IsA(index, scriptStructClass)) {
+        structs.push_back(index);
+      }
+    }
+  }
+
+  // Sizes and the lowest own property offset of every struct are read in parallel,
+  // the property chains stay cached for generation
+  sizes.assign(ObjTable.Num(), -1);
+  std::vector<int32> lowest(structs.size());
+  TaskPool::GetInstance()->ParallelFor((uint32)structs.size(), [&](uint32 i) {
+    auto object = UE_UStruct(ObjTable.Address[structs[i]]);
+    sizes[structs[i]] = object.GetSize();
+    lowest[i] = INT_MAX;
+    for (auto& prop : PropertyChain::Get(object).Properties) {
+      if (prop.IsFField && prop.Offset < lowest[i]) lowest[i] = prop.Offset;
+    }
+  });
+
+  std::vector<int32> original = sizes;
+  std::vector<int32> fixed;
+  for (size_t i = 0; i < structs.size(); i++) {
+    auto super = ObjTable.Super[structs[i]];
+    if (super == -1) continue;
+    if (sizes[super] == -1) {
+      printf("Unknow super for struct: %s\n", ObjTable.GetFullName(structs[i]).c_str());
+      continue;
+    }
+    if (lowest[i] < sizes[super]) {
+      if (sizes[super] == original[super]) fixed.push_back(super);
+      sizes[super] = lowest[i];
+    }
+  }
+  for (auto index : fixed) {
+    printf("Fixed class [%s] from 0x%X -> 0x%X \n", ObjTable.GetName(index).c_str(), original[index], sizes[index]);
+  }
+  return (int)fixed.size();
+}
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <unordered_set>
+#include "DumpScope.h"
+#include "ObjectTable.h"
+#include "PropertyChain.h"
+
+std::vector<bool> DumpScope::reachable;
+std::vector<bool> DumpScope::declared;
+std::vector<int32> DumpScope::pending;
+
+void DumpScope::Add(int32 index) {
+  if (index == -1 || reachable[index]) return;
+  reachable[index] = true;
+  pending.push_back(index);
+}
+
+void DumpScope::Declare(int32 index) {
+  if (index == -1) return;
+  declared[index] = true;
+}
+
+void DumpScope::AddType(TypeRef type, bool pointee) {
+  auto& node = TypeTable::Get(type);
+  if (node.Kind == TypeKind::Struct) {
+    // an object pointer only needs the pointee declared
+    if (node.Pointer || pointee) Declare(node.Ref);
+    else Add(node.Ref);
+  } else if (node.Kind == TypeKind::Enum) {
+    Add(node.Ref);
+  } else if (node.Kind == TypeKind::Template) {
+    // arguments of TWeakObjectPtr, TSoftObjectPtr, ... are object references as well
+    bool container = node.Name == "TArray" || node.Name == "TSet" || node.Name == "TMap";
+    for (auto arg : node.Args) AddType(arg, pointee || !container);
+  }
+}
+
+void DumpScope::Walk(int32 index) {
+  Add(ObjTable.Super[index]);
+
+  auto& chain = PropertyChain::Get(UE_UStruct(ObjTable.Address[index]));
+  for (auto& prop : chain.Properties) {
+    AddType(prop.Type.second);
+  }
+  for (auto fn : chain.Functions) {
+    for (auto& prop : PropertyChain::Get(fn).Properties) {
+      AddType(prop.Type.second);
+    }
+  }
+}
+
+uint32 DumpScope::Build(const std::vector<std::string>& roots) {
+  reachable.assign(ObjTable.Num(), false);
+  declared.assign(ObjTable.Num(), false);
+  pending.clear();
+
+  auto classClass = ObjTable.IndexOf(UE_UClass::StaticClass());
+  auto scriptStructClass = ObjTable.IndexOf(UE_UScriptStruct::StaticClass());
+  auto enumClass = ObjTable.IndexOf(UE_UEnum::StaticClass());
+
+  std::unordered_set<std::string> names(roots.begin(), roots.end());
+  for (uint32 i = 0; i < ObjTable.Num(); i++) {
+    if (!ObjTable.Address[i]) continue;
+    if (!ObjTable.IsA(i, classClass) && !ObjTable.IsA(i, scriptStructClass) && !ObjTable.IsA(i, enumClass)) continue;
+    if (names.count(ObjTable.GetName(i))) Add(i);
+  }
+
+  uint32 count = 0;
+  while (pending.size()) {
+    auto index = pending.back();
+    pending.pop_back();
+    count++;
+    if (!ObjTable.IsA(index, enumClass)) Walk(index);
+  }
+  // pointees that are reachable some other way are dumped in full
+  for (uint32 i = 0; i < ObjTable.Num(); i++) {
+    if (reachable[i]) declared[i] = false;
+  }
+  return count;
+}
+
+uint32 DumpScope::DeclaredCount() {
+  return (uint32)std::count(declared.begin(), declared.end(), true);
+}
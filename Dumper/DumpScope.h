@@ -0,0 +1,29 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "wrappers.h"
+
+// Dependency closure of a set of root types, used to dump only a part of the game.
+// Starting from the roots it follows super structs, struct/enum types of members
+// (including array/set/map elements) and of function parameters.
+// Object pointers are not followed, a pointee outside of the scope is only declared.
+class DumpScope
+{
+  static std::vector<bool> reachable;
+  static std::vector<bool> declared;
+  static std::vector<int32> pending;
+
+  static void Add(int32 index);
+  static void Declare(int32 index);
+  static void AddType(TypeRef type, bool pointee = false);
+  static void Walk(int32 index);
+
+public:
+  // Collects every class, struct and enum reachable from the roots (object names).
+  // Returns the number of collected types, 0 if none of the roots were found.
+  static uint32 Build(const std::vector<std::string>& roots);
+  static bool Contains(int32 index) { return index != -1 && reachable[index]; }
+  // Pointed to from the scope without being part of it, empty unless Build ran
+  static bool IsDeclared(int32 index) { return index >= 0 && index < (int32)declared.size() && declared[index]; }
+  static uint32 DeclaredCount();
+};
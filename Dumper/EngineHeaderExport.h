@@ -1,8 +1,8 @@
 #pragma once
 #include <string>
 #include <filesystem>
-#include <fmt/core.h>
-#include <fstream>
+#include <fmt/format.h>
+#include "FileWriter.h"
 #include "resource.h"
 /*
 * Author: BobH
@@ -19,7 +19,7 @@ class EngineHeaderExport
 public:
   static void ReplaceVAR(std::string& str);
   static bool LoadResourceText(std::string& str, int resourceID);
-  static inline void Process(std::filesystem::path dir) {
+  static inline void Process(std::filesystem::path dir, FileWriter& writer) {
     const static std::vector<std::pair<int, std::string>> EngineFiles = {
       std::make_pair(BASICTYPES_PACKAGE, "SDK/BasicTypes_Package.h"),
       std::make_pair(BASICTYPES_CLASSES, "SDK/BasicTypes_Classes.h"),
@@ -34,15 +34,15 @@ public:
     };
     // ļ
     for (auto& enginefile : EngineFiles) {
-      std::ofstream output(dir / enginefile.second);
       std::string content;
       if (!LoadResourceText(content, enginefile.first)) {
         printf("[ERROR] Fail to read engine header file: %s\n", enginefile.second.c_str());
         continue;
       }
       ReplaceVAR(content);
-      // fmt::print(file, "{}", content);
-      output << content;
+      fmt::memory_buffer output;
+      output.append(content.data(), content.data() + content.size());
+      writer.Write(dir / enginefile.second, std::move(output));
     }
   }
 };
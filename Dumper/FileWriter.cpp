@@ -0,0 +1,74 @@
+#include <fstream>
+#include <hash/hash.h>
+#include "FileWriter.h"
+#include "wrappers.h"
+
+static const char* ManifestName = "SDK.manifest";
+
+// Same FNV-1 as hash.h, but a loop, the constexpr one recurses once per byte
+static uint64 HashContent(const fmt::memory_buffer& content) {
+  uint64 hash = Basis;
+  for (auto c : content) {
+    hash = (hash * Prime) ^ (uint8)c;
+  }
+  return hash;
+}
+
+FileWriter::FileWriter(const fs::path& root, size_t capacity) : root(root), queue(capacity) {
+  LoadManifest();
+  worker = std::thread(&FileWriter::Run, this);
+}
+
+FileWriter::~FileWriter() { Finish(); }
+
+void FileWriter::LoadManifest() {
+  std::ifstream manifest(root / ManifestName);
+  uint64 hash;
+  std::string name;
+  while (manifest >> std::hex >> hash && std::getline(manifest >> std::ws, name)) {
+    previous[name] = hash;
+  }
+}
+
+void FileWriter::SaveManifest() {
+  File manifest(root / ManifestName, "w");
+  if (!manifest) return;
+  for (auto& [name, hash] : current) {
+    fmt::print(manifest, "{:016x} {}\n", hash, name);
+  }
+}
+
+void FileWriter::Run() {
+  Pending pending;
+  while (queue.Pop(pending)) {
+    File file(pending.Path, "w");
+    if (!file || fwrite(pending.Content.data(), 1, pending.Content.size(), file) != pending.Content.size()) {
+      std::lock_guard<std::mutex> guard(lock);
+      failed += (pending.Path.filename().string() + ", ");
+      current.erase(pending.Path.lexically_relative(root).generic_string());
+    }
+  }
+}
+
+bool FileWriter::Write(const fs::path& path, fmt::memory_buffer&& content) {
+  auto name = path.lexically_relative(root).generic_string();
+  auto hash = HashContent(content);
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    current[name] = hash;
+    auto it = previous.find(name);
+    if (it != previous.end() && it->second == hash && fs::exists(path)) return false;
+    changed++;
+  }
+  queue.Push({ path, std::move(content) });
+  return true;
+}
+
+std::string FileWriter::Finish() {
+  if (worker.joinable()) {
+    queue.Close();
+    worker.join();
+    SaveManifest();
+  }
+  return failed;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <fmt/format.h>
+#include "BoundedQueue.h"
+#include "defs.h"
+
+namespace fs = std::filesystem;
+
+// Writes finished files on a thread of its own.
+// Files are formatted into a buffer in memory and handed over whole, each one then
+// takes a single write, so formatting the next package never waits for the disk.
+// A manifest keeps the content hash of every file, files whose content did not change
+// since the last run are not written again and keep their modification time.
+class FileWriter {
+private:
+  struct Pending {
+    fs::path Path;
+    fmt::memory_buffer Content;
+  };
+
+  fs::path root;
+  std::mutex lock;
+  std::unordered_map<std::string, uint64> previous; // manifest of the last run
+  std::map<std::string, uint64> current;            // every file of this run, written or not
+  std::atomic<uint32> changed = 0;
+  std::string failed; // files that could not be written, separated by ", "
+
+  BoundedQueue<Pending> queue;
+  std::thread worker;
+
+  void Run();
+  void LoadManifest();
+  void SaveManifest();
+
+public:
+  // Files are written below 'root', which also holds the manifest
+  explicit FileWriter(const fs::path& root, size_t capacity = 64);
+  ~FileWriter();
+
+  // Returns false if the file is already on disk with the same content
+  bool Write(const fs::path& path, fmt::memory_buffer&& content);
+  // Files that were written so far
+  uint32 Changed() const { return changed; }
+  // No more files will be handed over, waits until the queued ones are on disk and
+  // returns the names of the ones that could not be written
+  std::string Finish();
+};
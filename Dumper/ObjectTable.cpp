@@ -0,0 +1,164 @@
+#include <algorithm>
+#include "ObjectTable.h"
+#include "TaskPool.h"
+#include "engine.h"
+#include "profiles.h"
+#include "memory.h"
+#include "wrappers.h"
+
+template <const auto& P> void ObjectTable::ReadObjects(std::vector<uint8*>& classPtr, std::vector<uint8*>& outerPtr) {
+  uint32 num = Num();
+
+  // FUObjectItem arrays are read one chunk at a time
+  std::vector<uint8> items;
+  for (uint32 chunkIndex = 0; chunkIndex < ObjObjects.NumChunks && chunkIndex * 65536ull < num; chunkIndex++) {
+    uint8* chunk = Read<uint8*>(ObjObjects.Objects + chunkIndex);
+    if (!chunk) continue;
+    uint32 first = chunkIndex * 65536;
+    uint32 count = std::min<uint32>(num - first, 65536);
+    items.resize((uint64)count * P.FUObjectItem.Size);
+    if (!Read(chunk, items.data(), items.size())) continue;
+    for (uint32 i = 0; i < count; i++) {
+      Address[first + i] = *(uint8**)(items.data() + (uint64)i * P.FUObjectItem.Size);
+    }
+  }
+
+  // UObject headers are independent reads, so they are spread over the pool
+  auto& o = P.UObject;
+  uint32 headerSize = std::max({ o.Index + 4, o.Class + 8, o.Name + P.FName.Number + 4, o.Outer + 8, o.Flags + 4 });
+  uint32 blocks = (num + BlockSize - 1) / BlockSize;
+  TaskPool::GetInstance()->ParallelFor(blocks, [&](uint32 block) {
+    std::vector<uint8> header(headerSize);
+    auto data = header.data();
+    auto end = std::min(num, (block + 1) * BlockSize);
+    for (uint32 id = block * BlockSize; id < end; id++) {
+      if (!Address[id]) continue;
+      if (!Read(Address[id], data, headerSize)) {
+        Address[id] = nullptr;
+        continue;
+      }
+      VTable[id] = *(uint8**)data;
+      Flags[id] = *(uint32*)(data + o.Flags);
+      Name[id] = *(uint32*)(data + o.Name);
+      Number[id] = *(uint32*)(data + o.Name + P.FName.Number);
+      classPtr[id] = *(uint8**)(data + o.Class);
+      outerPtr[id] = *(uint8**)(data + o.Outer);
+    }
+  });
+}
+
+void ObjectTable::Build() {
+  uint32 num = ObjObjects.NumElements;
+  Address.assign(num, nullptr);
+  VTable.assign(num, nullptr);
+  Class.assign(num, -1);
+  Outer.assign(num, -1);
+  Name.assign(num, 0);
+  Number.assign(num, 0);
+  Flags.assign(num, 0);
+  Package.assign(num, -1);
+  Super.assign(num, -1);
+  indexMp.clear();
+  indexMp.reserve(num);
+
+  std::vector<uint8*> classPtr(num, nullptr);
+  std::vector<uint8*> outerPtr(num, nullptr);
+
+  WithProfile([&]<const auto& P>() { ReadObjects<P>(classPtr, outerPtr); });
+
+  for (uint32 i = 0; i < num; i++) {
+    if (Address[i]) indexMp[Address[i]] = i;
+  }
+
+  for (uint32 i = 0; i < num; i++) {
+    Class[i] = IndexOf(classPtr[i]);
+    Outer[i] = IndexOf(outerPtr[i]);
+  }
+
+  // Super chains of every class in use, which is enough to answer IsA locally
+  std::vector<bool> superLoaded(num, false);
+  auto loadSuper = [&](int32 index) {
+    for (; index != -1 && !superLoaded[index]; index = Super[index]) {
+      superLoaded[index] = true;
+      Super[index] = IndexOf(Read<uint8*>(Address[index] + offsets.UStruct.SuperStruct));
+    }
+  };
+  for (uint32 i = 0; i < num; i++) {
+    loadSuper(Class[i]);
+  }
+  auto structClass = IndexOf(UE_UStruct::StaticClass());
+  for (uint32 i = 0; i < num; i++) {
+    if (Address[i] && IsA(i, structClass)) loadSuper(i);
+  }
+
+  // Outer chains are resolved in index order, memoizing the result of every outer
+  std::vector<bool> packageLoaded(num, false);
+  std::vector<int32> stack;
+  for (uint32 i = 0; i < num; i++) {
+    for (int32 index = i; index != -1 && !packageLoaded[index]; index = Outer[index]) {
+      stack.push_back(index);
+    }
+    while (stack.size()) {
+      auto index = stack.back();
+      stack.pop_back();
+      auto outer = Outer[index];
+      if (outer != -1) {
+        Package[index] = Package[outer] != -1 ? Package[outer] : outer;
+      }
+      packageLoaded[index] = true;
+    }
+  }
+}
+
+int32 ObjectTable::IndexOf(const void* address) const {
+  if (!address) return -1;
+  auto it = indexMp.find(address);
+  if (it == indexMp.end()) return -1;
+  return it->second;
+}
+
+bool ObjectTable::IsA(int32 index, int32 cmp) const {
+  if (index == -1 || cmp == -1) return false;
+  for (auto super = Class[index]; super != -1; super = Super[super]) {
+    if (super == cmp) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string ObjectTable::GetName(int32 index) const {
+  if (index == -1) return UE_FName::GetName(0, 0);
+  return UE_FName::GetName(Name[index], Number[index]);
+}
+
+std::string ObjectTable::GetFullName(int32 index) const {
+  std::string temp;
+  for (auto outer = Outer[index]; outer != -1; outer = Outer[outer]) {
+    temp = GetName(outer) + "." + temp;
+  }
+  return GetName(Class[index]) + " " + temp + GetName(index);
+}
+
+std::string ObjectTable::GetCppName(int32 index) const {
+  std::string name;
+  if (IsA(index, IndexOf(UE_UClass::StaticClass()))) {
+    auto actor = IndexOf(UE_AActor::StaticClass());
+    auto object = IndexOf(UE_UObject::StaticClass());
+    for (auto c = index; c != -1; c = Super[c]) {
+      if (c == actor) {
+        name = "A";
+        break;
+      } else if (c == object) {
+        name = "U";
+        break;
+      }
+    }
+  } else {
+    name = "F";
+  }
+
+  return name + GetName(index);
+}
+
+ObjectTable ObjTable;
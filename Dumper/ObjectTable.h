@@ -0,0 +1,41 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "generic.h"
+
+// Columnar snapshot of GUObjectArray.
+// It is filled by one pass over the remote array (one read per chunk of
+// FUObjectItem and one read per UObject header), so later phases can work on
+// local arrays indexed by the object index instead of re-reading the game.
+struct ObjectTable {
+  // Objects per task when a pass over the table is split between threads
+  static constexpr uint32 BlockSize = 4096;
+
+  std::vector<uint8*> Address; // UObject*, nullptr for empty slots
+  std::vector<uint8*> VTable;
+  std::vector<int32> Class;    // index of ClassPrivate
+  std::vector<int32> Outer;    // index of OuterPrivate
+  std::vector<uint32> Name;    // FName ComparisonIndex
+  std::vector<uint32> Number;  // FName Number
+  std::vector<uint32> Flags;   // EObjectFlags
+  std::vector<int32> Package;  // index of the outermost object, -1 for top level objects
+  std::vector<int32> Super;    // index of SuperStruct, only filled for UStruct objects
+
+  void Build();
+  uint32 Num() const { return (uint32)Address.size(); }
+  int32 IndexOf(const void* address) const;
+  bool IsA(int32 index, int32 cmp) const;
+  std::string GetName(int32 index) const;
+  std::string GetFullName(int32 index) const;
+  // Same prefixing as UE_UObject::GetCppName without reading the super chain
+  std::string GetCppName(int32 index) const;
+
+private:
+  std::unordered_map<const void*, int32> indexMp;
+
+  // Reads the FUObjectItem chunks and the UObject headers with the offsets of profile P
+  template <const auto& P> void ReadObjects(std::vector<uint8*>& classPtr, std::vector<uint8*>& outerPtr);
+};
+
+extern ObjectTable ObjTable;
@@ -0,0 +1,263 @@
+#include <cstring>
+#include "PackageIR.h"
+#include "memory.h"
+
+struct PackageIR::Writer {
+  static constexpr bool Loading = false;
+  std::vector<uint8>& out;
+
+  void Bytes(void* data, size_t size) {
+    out.insert(out.end(), (uint8*)data, (uint8*)data + size);
+  }
+};
+
+struct PackageIR::Reader {
+  static constexpr bool Loading = true;
+  const uint8* pos;
+  const uint8* end;
+  bool ok = true;
+
+  void Bytes(void* data, size_t size) {
+    if (!ok || size > (size_t)(end - pos)) {
+      ok = false;
+      memset(data, 0, size);
+      return;
+    }
+    memcpy(data, pos, size);
+    pos += size;
+  }
+};
+
+template <typename Io, typename T> requires (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+void PackageIR::Visit(Io& io, T& value) {
+  io.Bytes(&value, sizeof(T));
+}
+
+template <typename Io> void PackageIR::Visit(Io& io, std::string& str) {
+  uint32 size = (uint32)str.size();
+  Visit(io, size);
+  if constexpr (Io::Loading) {
+    if (!io.ok || size > (size_t)(io.end - io.pos)) {
+      io.ok = false;
+      return;
+    }
+    str.resize(size);
+  }
+  io.Bytes(str.data(), size);
+}
+
+template <typename Io, typename T> void PackageIR::Visit(Io& io, std::vector<T>& items) {
+  uint32 size = (uint32)items.size();
+  Visit(io, size);
+  if constexpr (Io::Loading) {
+    // every item takes at least one byte
+    if (!io.ok || size > (size_t)(io.end - io.pos)) {
+      io.ok = false;
+      return;
+    }
+    items.resize(size);
+  }
+  for (auto& item : items) {
+    Visit(io, item);
+  }
+}
+
+template <typename Io> void PackageIR::Visit(Io& io, TypeNode& node) {
+  Visit(io, node.Kind);
+  Visit(io, node.Keyword);
+  Visit(io, node.Pointer);
+  Visit(io, node.Ref);
+  Visit(io, node.Name);
+  Visit(io, node.Args);
+}
+
+template <typename Io> void PackageIR::Visit(Io& io, UE_UPackage::Member& member) {
+  Visit(io, member.isSuspectMember);
+  Visit(io, member.isStatic);
+  Visit(io, member.Type);
+  Visit(io, member.Name);
+  Visit(io, member.Offset);
+  Visit(io, member.Size);
+}
+
+template <typename Io> void PackageIR::Visit(Io& io, UE_UPackage::ParamInfo& param) {
+  Visit(io, param.Offset);
+  Visit(io, param.Size);
+  Visit(io, param.Name);
+  Visit(io, param.Type);
+  Visit(io, param.isOutRef);
+  Visit(io, param.isReturn);
+  Visit(io, param.flags);
+}
+
+template <typename Io> void PackageIR::Visit(Io& io, UE_UPackage::Function& func) {
+  Visit(io, func.paramInfo);
+  Visit(io, func.ParamTypes);
+  Visit(io, func.FuncFlag);
+  Visit(io, func.FuncName);
+  Visit(io, func.RetType);
+  Visit(io, func.FullName);
+  Visit(io, func.Flags);
+  Visit(io, func.GeneratedParamName);
+  Visit(io, func.declareStatic);
+  Visit(io, func.declareConst);
+  Visit(io, func.Func);
+  Visit(io, func.badDeclareFunc);
+  Visit(io, func.emptyParamStruct);
+}
+
+template <typename Io> void PackageIR::Visit(Io& io, UE_UPackage::Struct& stru) {
+  Visit(io, stru.Index);
+  Visit(io, stru.FullName);
+  Visit(io, stru.CppName);
+  Visit(io, stru.ClassName);
+  Visit(io, stru.SuperName);
+  Visit(io, stru.SuperIndex);
+  Visit(io, stru.Inherited);
+  Visit(io, stru.Size);
+  Visit(io, stru.Members);
+  Visit(io, stru.Functions);
+}
+
+template <typename Io> void PackageIR::Visit(Io& io, UE_UPackage::Enum& enm) {
+  Visit(io, enm.Index);
+  Visit(io, enm.FullName);
+  Visit(io, enm.CppName);
+  Visit(io, enm.EnumName);
+  Visit(io, enm.Members);
+}
+
+template <typename Io> void PackageIR::Visit(Io& io, UE_UPackage::Declaration& decl) {
+  Visit(io, decl.Index);
+  Visit(io, decl.Kind);
+  Visit(io, decl.Name);
+  Visit(io, decl.DeclareOnly);
+}
+
+template <typename Io> void PackageIR::Visit(Io& io, UE_UPackage& package) {
+  Visit(io, package.packageName);
+  Visit(io, package.Declarations);
+  Visit(io, package.Classes);
+  Visit(io, package.Structures);
+  Visit(io, package.Enums);
+}
+
+bool PackageIR::Write(const std::vector<uint8>& data) {
+  if (!*this) return false;
+  if (fwrite(data.data(), 1, data.size(), file) != data.size()) {
+    failed = true;
+    return false;
+  }
+  written += data.size();
+  return true;
+}
+
+PackageIR::PackageIR(const fs::path& path, const std::string& gameName) : file(path, "wb") {
+  Writer writer{ buffer };
+  auto magic = Magic;
+  auto version = Version;
+  uint64 trailer = 0; // patched by Finish
+  auto base = Base;
+  auto name = gameName;
+  Visit(writer, magic);
+  Visit(writer, version);
+  Visit(writer, trailer);
+  Visit(writer, base);
+  Visit(writer, name);
+  Write(buffer);
+}
+
+void PackageIR::Add(UE_UPackage& package) {
+  buffer.clear();
+  Writer writer{ buffer };
+  Visit(writer, package);
+  if (Write(buffer)) count++;
+}
+
+bool PackageIR::Finish() {
+  auto trailer = written;
+  buffer.clear();
+  Writer writer{ buffer };
+  // ids are positions in the table, node 0 is always the empty type and node 1 void
+  uint32 types = TypeTable::nodes.Size();
+  Visit(writer, types);
+  for (TypeRef i = 1; i < types; i++) {
+    auto node = TypeTable::Get(i);
+    Visit(writer, node);
+  }
+  uint32 strings = StringPool::strings.Size();
+  Visit(writer, strings);
+  for (StringRef i = 1; i < strings; i++) {
+    std::string str(StringPool::Get(i));
+    Visit(writer, str);
+  }
+  auto packageCount = count;
+  Visit(writer, packageCount);
+  if (!Write(buffer)) return false;
+
+  if (fseek(file, TrailerAt, SEEK_SET) || fwrite(&trailer, sizeof(trailer), 1, file) != 1 || fflush(file)) {
+    failed = true;
+  }
+  return *this;
+}
+
+bool PackageIR::Load(const fs::path& path, std::vector<UE_UPackage>& packages, std::string& gameName) {
+  std::vector<uint8> data;
+  {
+    File file(path, "rb");
+    if (!file) return false;
+    uint8 chunk[0x10000];
+    size_t size;
+    while ((size = fread(chunk, 1, sizeof(chunk), file))) {
+      data.insert(data.end(), chunk, chunk + size);
+    }
+  }
+
+  Reader reader{ data.data(), data.data() + data.size() };
+  uint32 magic = 0, version = 0;
+  Visit(reader, magic);
+  Visit(reader, version);
+  if (magic != Magic || version != Version) {
+    printf("[ERROR] %s is not an IR of this version\n", path.string().c_str());
+    return false;
+  }
+  uint64 trailerAt = 0;
+  Visit(reader, trailerAt);
+  Visit(reader, Base);
+  Visit(reader, gameName);
+  if (!reader.ok || trailerAt < (uint64)(reader.pos - data.data()) || trailerAt > data.size()) {
+    printf("[ERROR] %s is damaged\n", path.string().c_str());
+    return false;
+  }
+
+  // the packages only hold ids, so the tables are restored first
+  Reader trailer{ data.data() + trailerAt, data.data() + data.size() };
+  uint32 types = 0;
+  Visit(trailer, types);
+  for (TypeRef i = 1; i < types && trailer.ok; i++) {
+    TypeNode node;
+    Visit(trailer, node);
+    // nodes and strings come in id order, so interning them again gives back the saved ids
+    if (TypeTable::Intern(std::move(node)) != i) trailer.ok = false;
+  }
+
+  uint32 strings = 0;
+  Visit(trailer, strings);
+  for (StringRef i = 1; i < strings && trailer.ok; i++) {
+    std::string str;
+    Visit(trailer, str);
+    if (StringPool::Intern(str) != i) trailer.ok = false;
+  }
+
+  uint32 count = 0;
+  Visit(trailer, count);
+  reader.end = data.data() + trailerAt;
+  for (uint32 i = 0; i < count && reader.ok && trailer.ok; i++) {
+    Visit(reader, packages.emplace_back());
+  }
+  if (!reader.ok || !trailer.ok || reader.pos != reader.end || trailer.pos != trailer.end) {
+    printf("[ERROR] %s is damaged\n", path.string().c_str());
+    return false;
+  }
+  return true;
+}
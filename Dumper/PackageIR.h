@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "wrappers.h"
+
+// Generated packages kept in a file, so the SDK can be written again without the game.
+// Holds what the reference solver and the Save* writers read: the declarations and
+// generated types of every package, the type and string tables they point into and the
+// module base. Packages go to the file as they are added, the tables only grow while
+// packages are generated and follow them in a trailer the header points at.
+class PackageIR {
+private:
+  static constexpr uint32 Magic = 0x52494453; // "SDIR"
+  static constexpr uint32 Version = 4;
+  static constexpr long TrailerAt = 8; // the trailer offset follows magic and version
+
+  struct Writer;
+  struct Reader;
+
+  File file;
+  std::vector<uint8> buffer; // the package being written, kept to reuse its memory
+  uint64 written = 0;        // bytes in the file so far
+  uint32 count = 0;
+  bool failed = false;
+
+  bool Write(const std::vector<uint8>& data);
+
+  template <typename Io, typename T> requires (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+  static void Visit(Io& io, T& value);
+  template <typename Io> static void Visit(Io& io, std::string& str);
+  template <typename Io, typename T> static void Visit(Io& io, std::vector<T>& items);
+  template <typename Io> static void Visit(Io& io, TypeNode& node);
+  template <typename Io> static void Visit(Io& io, UE_UPackage::Member& member);
+  template <typename Io> static void Visit(Io& io, UE_UPackage::ParamInfo& param);
+  template <typename Io> static void Visit(Io& io, UE_UPackage::Function& func);
+  template <typename Io> static void Visit(Io& io, UE_UPackage::Struct& stru);
+  template <typename Io> static void Visit(Io& io, UE_UPackage::Enum& enm);
+  template <typename Io> static void Visit(Io& io, UE_UPackage::Declaration& decl);
+  template <typename Io> static void Visit(Io& io, UE_UPackage& package);
+
+public:
+  // Creates the file and writes the header
+  PackageIR(const fs::path& path, const std::string& gameName);
+  operator bool() const { return file && !failed; }
+
+  // Writes a generated package, before the solver touches it
+  void Add(UE_UPackage& package);
+  // Writes the type and string tables after the packages and points the header at them
+  bool Finish();
+  // Reads the packages back in the order they were added, restores the type and string
+  // tables and the module base. Nothing may be interned before.
+  static bool Load(const fs::path& path, std::vector<UE_UPackage>& packages, std::string& gameName);
+};
@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <cstring>
+#include "PropertyChain.h"
+#include "engine.h"
+#include "profiles.h"
+#include "memory.h"
+#include "ObjectTable.h"
+
+std::mutex PropertyChain::lock;
+std::unordered_map<void*, PropertyChain> PropertyChain::chainMp;
+
+template <typename T> static T Field(const uint8* data, uint16 offset) {
+  T value;
+  memcpy(&value, data + offset, sizeof(T));
+  return value;
+}
+
+template <typename T> static T Field(const std::vector<uint8>& body, uint16 offset) {
+  return Field<T>(body.data(), offset);
+}
+
+// Types of the kinds that are always spelled the same, 0 for every other kind
+typedef std::vector<TypeRef> FixedTypes;
+
+static FixedTypes MakeFixedTypes(std::initializer_list<std::pair<PropertyType, TypeRef>> types) {
+  FixedTypes fixed((size_t)PropertyType::LazyObjectProperty + 1, 0);
+  for (auto& type : types) fixed[(size_t)type.first] = type.second;
+  return fixed;
+}
+
+// Where the fields of a property node live, per offsets profile and kind of property chain
+template <const auto& P, typename Prop> struct PropertyLayout;
+
+template <const auto& P> struct PropertyLayout<P, UE_FProperty> {
+  typedef UE_FFieldClass Class;
+  static constexpr bool IsFField = true;
+  static uint16 ClassPtr() { return P.FField.Class; }
+  static uint16 Next() { return P.FField.Next; }
+  static uint16 Name() { return P.FField.Name; }
+  static const auto& Fields() { return P.FProperty; }
+  static TypeRef Fixed(PropertyType kind) {
+    static const auto types = MakeFixedTypes({
+      { PropertyType::FloatProperty, TypeTable::Basic("float") },
+      { PropertyType::IntProperty, TypeTable::Basic("int32_t") },
+      { PropertyType::Int8Property, TypeTable::Basic("int8_t") },
+      { PropertyType::Int16Property, TypeTable::Basic("int16_t") },
+      { PropertyType::Int64Property, TypeTable::Basic("int64_t") },
+      { PropertyType::UInt16Property, TypeTable::Basic("uint16_t") },
+      { PropertyType::UInt32Property, TypeTable::Basic("uint32_t") },
+      { PropertyType::UInt64Property, TypeTable::Basic("uint64_t") },
+      { PropertyType::NameProperty, TypeTable::Basic("FName", TypeKeyword::Struct) },
+      { PropertyType::DelegateProperty, TypeTable::Basic("FDelegate", TypeKeyword::Struct) },
+      { PropertyType::StrProperty, TypeTable::Basic("FString", TypeKeyword::Struct) },
+      { PropertyType::TextProperty, TypeTable::Basic("FText", TypeKeyword::Struct) },
+      { PropertyType::MulticastSparseDelegateProperty, TypeTable::Basic("FMulticastSparseDelegate", TypeKeyword::Struct) },
+      { PropertyType::DoubleProperty, TypeTable::Basic("double") },
+      { PropertyType::MulticastDelegateProperty, TypeTable::Basic("FMulticastDelegate") },
+      { PropertyType::MulticastInlineDelegateProperty, TypeTable::Basic("FMulticastInlineDelegate", TypeKeyword::Struct) },
+    });
+    return types[(size_t)kind];
+  }
+};
+
+template <const auto& P> struct PropertyLayout<P, UE_UProperty> {
+  typedef UE_UClass Class;
+  static constexpr bool IsFField = false;
+  static uint16 ClassPtr() { return P.UObject.Class; }
+  static uint16 Next() { return P.UField.Next; }
+  static uint16 Name() { return P.UObject.Name; }
+  static const auto& Fields() { return P.UProperty; }
+  static TypeRef Fixed(PropertyType kind) {
+    static const auto types = MakeFixedTypes({
+      { PropertyType::DoubleProperty, TypeTable::Basic("double") },
+      { PropertyType::FloatProperty, TypeTable::Basic("float") },
+      { PropertyType::IntProperty, TypeTable::Basic("int") },
+      { PropertyType::Int16Property, TypeTable::Basic("int16") },
+      { PropertyType::Int64Property, TypeTable::Basic("int64") },
+      { PropertyType::Int8Property, TypeTable::Basic("uint8") },
+      { PropertyType::UInt16Property, TypeTable::Basic("uint16") },
+      { PropertyType::UInt32Property, TypeTable::Basic("uint32") },
+      { PropertyType::UInt64Property, TypeTable::Basic("uint64") },
+      { PropertyType::TextProperty, TypeTable::Basic("FText", TypeKeyword::Struct) },
+      { PropertyType::StrProperty, TypeTable::Basic("FString", TypeKeyword::Struct) },
+      { PropertyType::NameProperty, TypeTable::Basic("FName", TypeKeyword::Struct) },
+      { PropertyType::MulticastDelegateProperty, TypeTable::Basic("FScriptMulticastDelegate", TypeKeyword::Struct) },
+    });
+    return types[(size_t)kind];
+  }
+};
+
+// Bytes at the start of a node that hold every field decoded from it, including the
+// extra fields of reference-like, struct, enum, bool and container properties that
+// follow the base fields
+template <const auto& P, typename Prop> static uint16 BodySize() {
+  typedef PropertyLayout<P, Prop> Layout;
+  auto& fields = Layout::Fields();
+  return (std::max)({ (uint16)(fields.Size + PropertyExtraSize), (uint16)(Layout::ClassPtr() + 8),
+    (uint16)(Layout::Next() + 8), (uint16)(Layout::Name() + 8),
+    (uint16)(fields.ArrayDim + 4), (uint16)(fields.ElementSize + 4),
+    (uint16)(fields.Offset + 4), (uint16)(fields.PropertyFlags + 8) });
+}
+
+// Type named after the class of a property of unknown kind, one name read per class
+template <typename Class> static TypeRef ClassNameType(uint8* cls) {
+  static std::mutex lock;
+  static std::unordered_map<uint8*, TypeRef> typeMp;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = typeMp.find(cls);
+    if (it != typeMp.end()) return it->second;
+  }
+  auto type = TypeTable::Basic(Class(cls).GetName());
+  std::lock_guard<std::mutex> guard(lock);
+  typeMp.emplace(cls, type);
+  return type;
+}
+
+template <const auto& P, typename Prop> static type DecodeType(const std::vector<uint8>& body);
+
+// Type of an inner property of a container, decoded from one read of its node
+template <const auto& P, typename Prop> static TypeRef DecodeInner(uint8* node) {
+  std::vector<uint8> body(BodySize<P, Prop>());
+  if (!node || !Read(node, body.data(), body.size())) return 0;
+  return DecodeType<P, Prop>(body).second;
+}
+
+// Type of a property of a kind that points at other objects or properties. 'extra' are
+// the fields following the base property fields, objects are named through ObjTable.
+template <const auto& P, typename Prop, PropertyType Kind> static TypeRef DecodeKind(const uint8* extra) {
+  if constexpr (Kind == PropertyType::StructProperty) {
+    auto index = ObjTable.IndexOf(Field<uint8*>(extra, 0));
+    return TypeTable::Struct(index, ObjTable.GetCppName(index));
+  } else if constexpr (Kind == PropertyType::ByteProperty) {
+    auto e = Field<uint8*>(extra, 0);
+    if (!e) return TypeTable::Basic("char");
+    auto index = ObjTable.IndexOf(e);
+    return TypeTable::Enum(index, ObjTable.GetName(index));
+  } else if constexpr (Kind == PropertyType::EnumProperty) {
+    // the underlying property comes first
+    auto index = ObjTable.IndexOf(Field<uint8*>(extra, 8));
+    return TypeTable::Enum(index, ObjTable.GetName(index));
+  } else if constexpr (Kind == PropertyType::BoolProperty) {
+    static const auto boolType = TypeTable::Basic("bool");
+    static const auto charType = TypeTable::Basic("char");
+    return extra[3] == 0xFF ? boolType : charType;
+  } else if constexpr (Kind == PropertyType::ArrayProperty) {
+    return TypeTable::Template("TArray", { DecodeInner<P, Prop>(Field<uint8*>(extra, 0)) });
+  } else if constexpr (Kind == PropertyType::SetProperty) {
+    return TypeTable::Template("TSet", { DecodeInner<P, Prop>(Field<uint8*>(extra, 0)) });
+  } else if constexpr (Kind == PropertyType::MapProperty) {
+    return TypeTable::Template("TMap", { DecodeInner<P, Prop>(Field<uint8*>(extra, 0)), DecodeInner<P, Prop>(Field<uint8*>(extra, 8)) });
+  } else {
+    return ResolveReferenceType(Kind, extra);
+  }
+}
+
+template <const auto& P, typename Prop> static type DecodeType(const std::vector<uint8>& body) {
+  typedef PropertyLayout<P, Prop> Layout;
+  auto cls = Field<uint8*>(body, Layout::ClassPtr());
+  auto kind = Prop::KindOf(typename Layout::Class(cls));
+  auto extra = body.data() + Layout::Fields().Size;
+
+  switch (kind) {
+  case PropertyType::StructProperty: return { kind, DecodeKind<P, Prop, PropertyType::StructProperty>(extra) };
+  case PropertyType::ByteProperty: return { kind, DecodeKind<P, Prop, PropertyType::ByteProperty>(extra) };
+  case PropertyType::EnumProperty: return { kind, DecodeKind<P, Prop, PropertyType::EnumProperty>(extra) };
+  case PropertyType::BoolProperty: return { kind, DecodeKind<P, Prop, PropertyType::BoolProperty>(extra) };
+  case PropertyType::ArrayProperty: return { kind, DecodeKind<P, Prop, PropertyType::ArrayProperty>(extra) };
+  case PropertyType::SetProperty: return { kind, DecodeKind<P, Prop, PropertyType::SetProperty>(extra) };
+  case PropertyType::MapProperty: return { kind, DecodeKind<P, Prop, PropertyType::MapProperty>(extra) };
+  case PropertyType::ObjectProperty: return { kind, DecodeKind<P, Prop, PropertyType::ObjectProperty>(extra) };
+  case PropertyType::ClassProperty: return { kind, DecodeKind<P, Prop, PropertyType::ClassProperty>(extra) };
+  case PropertyType::SoftObjectProperty: return { kind, DecodeKind<P, Prop, PropertyType::SoftObjectProperty>(extra) };
+  case PropertyType::SoftClassProperty: return { kind, DecodeKind<P, Prop, PropertyType::SoftClassProperty>(extra) };
+  case PropertyType::WeakObjectProperty: return { kind, DecodeKind<P, Prop, PropertyType::WeakObjectProperty>(extra) };
+  case PropertyType::LazyObjectProperty: return { kind, DecodeKind<P, Prop, PropertyType::LazyObjectProperty>(extra) };
+  case PropertyType::InterfaceProperty: return { kind, DecodeKind<P, Prop, PropertyType::InterfaceProperty>(extra) };
+  case PropertyType::FieldPathProperty: return { kind, DecodeKind<P, Prop, PropertyType::FieldPathProperty>(extra) };
+  default: {
+    if (auto fixed = Layout::Fixed(kind)) return { kind, fixed };
+    return { PropertyType::Unknown, ClassNameType<typename Layout::Class>(cls) };
+  }
+  }
+}
+
+template <const auto& P, typename Prop> static PropertyRecord Decode(uint8* node, const std::vector<uint8>& body) {
+  typedef PropertyLayout<P, Prop> Layout;
+  auto& fields = Layout::Fields();
+  PropertyRecord record;
+  record.Address = node;
+  record.IsFField = Layout::IsFField;
+  record.Name = UE_FName::GetName(Field<uint32>(body, Layout::Name()), Field<uint32>(body, Layout::Name() + P.FName.Number));
+  record.ArrayDim = Field<int32>(body, fields.ArrayDim);
+  record.ElementSize = Field<int32>(body, fields.ElementSize);
+  record.Offset = Field<int32>(body, fields.Offset);
+  record.PropertyFlags = Field<uint64>(body, fields.PropertyFlags);
+  record.Type = DecodeType<P, Prop>(body);
+  if (record.Type.first == PropertyType::BoolProperty) {
+    record.FieldMask = body[fields.Size + 3];
+  }
+  return record;
+}
+
+template <const auto& P> PropertyChain PropertyChain::Load(UE_UStruct object) {
+  PropertyChain chain;
+  std::vector<uint8> body;
+
+  // FField chains only exist since 4.25, the whole loop folds away for older profiles
+  if (P.UStruct.ChildProperties) {
+    body.resize(BodySize<P, UE_FProperty>());
+    auto node = Read<uint8*>((uint8*)object + P.UStruct.ChildProperties);
+    for (; node; node = Field<uint8*>(body, PropertyLayout<P, UE_FProperty>::Next())) {
+      if (!Read(node, body.data(), body.size())) break;
+      chain.Properties.push_back(Decode<P, UE_FProperty>(node, body));
+    }
+  }
+
+  auto propertyClass = ObjTable.IndexOf(UE_UProperty::StaticClass());
+  auto functionClass = ObjTable.IndexOf(UE_UFunction::StaticClass());
+  body.resize(BodySize<P, UE_UProperty>());
+  auto node = Read<uint8*>((uint8*)object + P.UStruct.Children);
+  for (; node; node = Field<uint8*>(body, PropertyLayout<P, UE_UProperty>::Next())) {
+    if (!Read(node, body.data(), body.size())) break;
+    auto index = ObjTable.IndexOf(node);
+    if (ObjTable.IsA(index, propertyClass)) {
+      chain.Properties.push_back(Decode<P, UE_UProperty>(node, body));
+    } else if (ObjTable.IsA(index, functionClass)) {
+      chain.Functions.push_back(UE_UFunction(node));
+    }
+  }
+  return chain;
+}
+
+const PropertyChain& PropertyChain::Get(UE_UStruct object) {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = chainMp.find(object.GetAddress());
+    if (it != chainMp.end()) return it->second;
+  }
+  auto chain = WithProfile([&]<const auto& P>() { return Load<P>(object); });
+  std::lock_guard<std::mutex> guard(lock);
+  return chainMp.try_emplace(object.GetAddress(), std::move(chain)).first->second;
+}
+
+void PropertyChain::Release(UE_UStruct object) {
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = chainMp.find(object.GetAddress());
+  if (it == chainMp.end()) return;
+  for (auto fn : it->second.Functions) {
+    chainMp.erase(fn.GetAddress());
+  }
+  chainMp.erase(it);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "wrappers.h"
+
+// Fixed fields of one FProperty/UProperty, decoded from a single read of its body.
+struct PropertyRecord {
+  uint8* Address = nullptr;
+  bool IsFField = true; // FProperty from ChildProperties, UProperty from Children otherwise
+  std::string Name;
+  int32 ArrayDim = 0;
+  int32 ElementSize = 0;
+  int32 Offset = 0;
+  uint64 PropertyFlags = 0;
+  uint8 FieldMask = 0; // only read for bool properties
+  type Type;
+};
+
+// Properties and functions of a struct (or parameters of a function).
+// Both the ChildProperties and the Children chain are walked once with one read
+// per node, size fixing and struct/function generation share the cached result.
+struct PropertyChain {
+  std::vector<PropertyRecord> Properties; // FField chain first, then UProperty children
+  std::vector<UE_UFunction> Functions;    // UFunction children in declaration order
+
+  // Loads the chains of the struct on first use
+  static const PropertyChain& Get(UE_UStruct object);
+  // Drops the cached chains of a generated struct and of its functions
+  static void Release(UE_UStruct object);
+
+private:
+  static std::mutex lock;
+  static std::unordered_map<void*, PropertyChain> chainMp;
+
+  template <const auto& P> static PropertyChain Load(UE_UStruct object);
+};
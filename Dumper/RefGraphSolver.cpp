@@ -1,11 +1,16 @@
 #include "RefGraphSolver.h"
 
-std::unordered_map<std::string, std::string> RefGraphSolver::typeDefMap;
+std::unordered_map<std::string, int32> RefGraphSolver::typeDefMap;
+std::vector<int32> RefGraphSolver::refDefMap;
 
 
-std::vector<RefGraphSolver::Node*> RefGraphSolver::packageNodes;
+std::unordered_map<std::string, int32> RefGraphSolver::packageIds;
 
-std::unordered_map<std::string, RefGraphSolver::Node*> RefGraphSolver::nodesMap;
+std::vector<std::string> RefGraphSolver::packageNames;
+
+RefGraphSolver::Graph RefGraphSolver::packageGraph;
+std::vector<RefGraphSolver::PackageRefs> RefGraphSolver::packageRefs;
+std::vector<std::pair<int, int32>> RefGraphSolver::typePositions;
 
 std::vector<std::string> RefGraphSolver::packageHeaderOrder;
 
@@ -3,11 +3,13 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <algorithm>
 #include <cassert>
 #include <fmt/core.h>
 #include <fstream>
 #include <queue>
 #include "wrappers.h"
+#include "ObjectTable.h"
 
 /*
 * Author: BobH
@@ -26,179 +28,194 @@ const bool ignoreFuncParamRef = true; // 
 
 class RefGraphSolver
 {
-  struct Node {
-    Node() {
-      packageName = "";
-      indeg = 0;
-      outdeg = 0;
-      neighbors = std::vector<Node*>();
+  // Dependency graph over dense ids. Edges are collected in the order they are added
+  // and packed into compressed sparse rows when sorted, a node's dependents keep the
+  // order their edges were added in.
+  struct Graph {
+    std::vector<int32> referees; // edge i: referers[i] depends on referees[i]
+    std::vector<int32> referers;
+
+    void AddEdge(int32 referer, int32 referee) {
+      referees.push_back(referee);
+      referers.push_back(referer);
     }
-    Node(std::string name) {
-      static int id = 0;
-      debug_id = ++id;
-      packageName = name;
-      indeg = 0;
-      outdeg = 0;
-      neighbors = std::vector<Node*>();
+
+    // Kahn's algorithm over nodes [0, count). The queue is seeded with the nodes of
+    // 'seeds' that have no dependency, in that order. Nodes on a cycle are left out.
+    std::vector<int32> Sort(int32 count, const std::vector<int32>& seeds) const {
+      std::vector<int32> offsets(count + 1, 0);
+      std::vector<int32> indeg(count, 0);
+      for (size_t i = 0; i < referees.size(); i++) {
+        offsets[referees[i] + 1]++;
+        indeg[referers[i]]++;
+      }
+      for (int32 i = 0; i < count; i++) {
+        offsets[i + 1] += offsets[i];
+      }
+      std::vector<int32> dependents(referees.size());
+      std::vector<int32> fill(offsets.begin(), offsets.end() - 1);
+      for (size_t i = 0; i < referees.size(); i++) {
+        dependents[fill[referees[i]]++] = referers[i];
+      }
+
+      std::vector<int32> order;
+      order.reserve(count);
+      for (auto node : seeds) {
+        if (indeg[node] == 0) order.push_back(node);
+      }
+      // 'order' doubles as the queue, everything before 'head' is popped
+      for (size_t head = 0; head < order.size(); head++) {
+        auto node = order[head];
+        for (int32 i = offsets[node]; i < offsets[node + 1]; i++) {
+          if (--indeg[dependents[i]] == 0) order.push_back(dependents[i]);
+        }
+      }
+      return order;
     }
-    std::string packageName;
-    std::vector<Node*> neighbors;
-    int indeg, outdeg;
-    int debug_id;
   };
 
-  // map the TypeName -> PackageName
-  static std::unordered_map<std::string, std::string> typeDefMap;
+  // map the TypeName -> package id
+  static std::unordered_map<std::string, int32> typeDefMap;
 
+  // map the object index of a dumped struct/enum -> package id, -1 if not dumped,
+  // DeclaredOnly if a scoped dump only points to it
+  static std::vector<int32> refDefMap;
+  static constexpr int32 DeclaredOnly = -2;
 
-  // map the packageName -> NodePointer
-  static std::unordered_map<std::string, Node*> nodesMap;
+  // map the object index of a class/struct of the package being ordered -> kind (1 class,
+  // 2 struct) and position in its vector, {0, -1} for every other object
+  static std::vector<std::pair<int, int32>> typePositions;
 
-  // Store all the package nodes for topo sort
-  static std::vector<Node*> packageNodes;
+  // map the packageName -> package id
+  static std::unordered_map<std::string, int32> packageIds;
+
+  // Names of the package nodes for topo sort, by package id
+  static std::vector<std::string> packageNames;
+
+  // packageReferer -> packageReferee edges
+  static Graph packageGraph;
+
+  // What the header of a package needs from other packages
+  struct PackageRefs {
+    std::vector<int32> includes; // packages whose complete types are used, reduced by SortPackages
+    std::vector<std::pair<int32, std::string>> declares; // types only pointed to: package id or DeclaredOnly, "struct X"
+  };
+
+  // by package id
+  static std::vector<PackageRefs> packageRefs;
 
   // ӲԴͶ壬Ҫֶȡдȥ
   static std::vector<std::string> BasicTypes;
   static std::vector<std::string> CoreUObject;
   static std::vector<std::string> CppTypes;
 
-  static void PushNode(std::string packageName) {
-    auto newNode = new Node(packageName);
-    nodesMap[packageName] = newNode;
-    packageNodes.push_back(newNode);
+  static int32 PushNode(std::string packageName) {
+    int32 id = (int32)packageNames.size();
+    packageIds[packageName] = id;
+    packageNames.push_back(packageName);
+    packageRefs.emplace_back();
+    return id;
   }
 
   static void LoadUnrealPackageDef() {
     // ԴһЩĶ壬Щ岻ǴϷdumpģǴпٳģҪ
+    auto basicTypes = PushNode("BasicTypes");
+    auto coreUObject = PushNode("CoreUObject");
+    auto cppTypes = PushNode("CppTypes");
     for (auto ClassName : BasicTypes) {
-      typeDefMap[ClassName] = "BasicTypes";
+      typeDefMap[ClassName] = basicTypes;
     }
     for (auto ClassName : CoreUObject) {
-      typeDefMap[ClassName] = "CoreUObject";
+      typeDefMap[ClassName] = coreUObject;
     }
     for (auto ClassName : CppTypes) {
-      typeDefMap[ClassName] = "CppTypes";
+      typeDefMap[ClassName] = cppTypes;
     }
-    PushNode("BasicTypes");
-    PushNode("CoreUObject");
-    PushNode("CppTypes");
   }
 
+  // Package defining the type, by object index when it was dumped, by name otherwise.
+  // DeclaredOnly types have no package, every header that uses them declares them.
+  static int32 FindTypePackage(const TypeNode& node) {
+    if (node.Ref >= 0 && node.Ref < (int32)refDefMap.size() && refDefMap[node.Ref] != -1) {
+      return refDefMap[node.Ref];
+    }
+    auto it = typeDefMap.find(node.Name);
+    if (it == typeDefMap.end()) return -1;
+    return it->second;
+  }
 
+  // True if the type and all of its template arguments are defined by some package
+  static bool IsTypeDefined(TypeRef type) {
+    bool defined = true;
+    TypeTable::ForEach(type, [&defined](const TypeNode& node) {
+      if (FindTypePackage(node) == -1) defined = false;
+    });
+    return defined;
+  }
 
-  static std::string GetPureTypeName(std::string fullTypeName) {
-    auto removeSubstring = [](std::string& input, const std::string toRemove) {
-      size_t pos = input.find(toRemove);
-      while (pos != std::string::npos) {
-        input.erase(pos, toRemove.length());
-        pos = input.find(toRemove, pos);
-      }
-    };
-    auto trim = [](std::string& input) {
-      if (input == "") return;
-      size_t start = 0;
-      size_t end = input.length() - 1;
-
-      // Find the first non-space character from the beginning of the string
-      while (start <= end && std::isspace(input[start])) {
-        start++;
-      }
-
-      // Find the last non-space character from the end of the string
-      while (end >= start && std::isspace(input[end])) {
-        end--;
-      }
-
-      // Return the trimmed substring
-      input = input.substr(start, end - start + 1);
-    };
-    std::string res = fullTypeName;
-    removeSubstring(res, "static");
-    removeSubstring(res, "enum");
-    removeSubstring(res, "class");
-    removeSubstring(res, "struct");
-    removeSubstring(res, "*");
-    trim(res);
-    return res;
+  static void AddTypePackages(TypeRef type, std::vector<int32>& packages) {
+    TypeTable::ForEach(type, [&packages](const TypeNode& node) {
+      auto package = FindTypePackage(node);
+      if (package >= 0) packages.push_back(package);
+    });
   }
 
-  static std::vector<std::string> GetGenericTypes(std::string genericTypeName) {
-    auto removeSubstring = [](std::string& input, const std::string toRemove) {
-      size_t pos = input.find(toRemove);
-      while (pos != std::string::npos) {
-        input.erase(pos, toRemove.length());
-        pos = input.find(toRemove, pos);
-      }
-    };
-    auto splitString = [](const std::string& input, const std::string& delimiters) {
-      std::vector<std::string> tokens;
-      std::string::size_type startPos = 0;
-      std::string::size_type endPos = 0;
-
-      while (endPos != std::string::npos) {
-        endPos = input.find_first_of(delimiters, startPos);
-
-        // ҵ˷ָ
-        if (endPos != startPos) {
-          std::string token = input.substr(startPos, endPos - startPos);
-          tokens.push_back(token);
-        }
+  // A struct that is only pointed to, or passed to a template, is declared instead of
+  // included. Enums and basic types can not be declared and always pull in their package.
+  static void AddIncludeRefs(TypeRef type, PackageRefs& refs, bool complete = true) {
+    auto& node = TypeTable::Get(type);
+    if (node.Kind == TypeKind::Opaque) return;
+    auto package = FindTypePackage(node);
+    if (package == -1) return;
+    if (node.Kind == TypeKind::Struct && (node.Pointer || !complete || package == DeclaredOnly)) {
+      refs.declares.push_back({ package, fmt::format("{} {}", node.Keyword == TypeKeyword::Class ? "class" : "struct", node.Name) });
+    }
+    else {
+      refs.includes.push_back(package);
+    }
+    for (auto arg : node.Args) AddIncludeRefs(arg, refs, false);
+  }
 
-        // ָһӴ
-        if (endPos != std::string::npos) {
-          startPos = endPos + 1;
-        }
-      }
-      tokens.pop_back();
-      return tokens;
-    };
-    removeSubstring(genericTypeName, " ");
-    const std::string delimiters = "<>,";
-    return splitString(genericTypeName, delimiters);
+  static bool IsTemplate(TypeRef type) {
+    return TypeTable::Get(type).Kind == TypeKind::Template;
   }
 
   static void LoadPackageDef(UE_UPackage& package) {
     std::string packageName = package.packageName;
     if (packageName == "CoreUObject") return;
-    for (auto& klass : package.Classes) {
-      typeDefMap[klass.ClassName] = packageName;
-    }
-    for (auto& stru : package.Structures) {
-      typeDefMap[stru.ClassName] = packageName;
+    for (auto& decl : package.Declarations) {
+      if (!decl.DeclareOnly) continue;
+      if (decl.Index >= (int32)refDefMap.size()) refDefMap.resize(decl.Index + 1, -1);
+      refDefMap[decl.Index] = DeclaredOnly;
     }
-    for (auto& enums : package.Enums) {
-      typeDefMap[enums.EnumName] = packageName;
+    // a package that only declares gets no header
+    bool defines = std::any_of(package.Declarations.begin(), package.Declarations.end(), [](const UE_UPackage::Declaration& decl) {
+      return !decl.DeclareOnly;
+    });
+    if (!defines) return;
+    auto id = PushNode(packageName);
+    for (auto& decl : package.Declarations) {
+      if (decl.DeclareOnly) continue;
+      if (decl.Index >= (int32)refDefMap.size()) refDefMap.resize(decl.Index + 1, -1);
+      refDefMap[decl.Index] = id;
+      typeDefMap[decl.Name] = id;
     }
-    if(package.Classes.size() || package.Structures.size() || package.Enums.size()) PushNode(packageName);
   }
 
-  static bool AddEdge(std::string packageReferer, std::string packageReferee) {
+  static void AddEdge(int32 packageReferer, int32 packageReferee) {
     static std::ofstream output("relation.txt");
     // packageReferer -> packageReferee
-    if (nodesMap.count(packageReferer) == 0) {
-      printf("Could not found Referer class node \"%s\"!", packageReferer.c_str());
-      return false;
-    }
-    if (nodesMap.count(packageReferee) == 0) {
-      printf("Could not found Referee class node \"%s\"!", packageReferee.c_str() );
-      return false;
-    }
-    auto pReferer = nodesMap[packageReferer];
-    auto pReferee = nodesMap[packageReferee];
-    pReferer->indeg++;
-    pReferee->outdeg++;
-    pReferee->neighbors.push_back(pReferer);
-    output << pReferer->packageName << " referes " << pReferee->packageName << std::endl;
-    return true;
+    packageGraph.AddEdge(packageReferer, packageReferee);
+    output << packageNames[packageReferer] << " referes " << packageNames[packageReferee] << std::endl;
   }
 
   static void FixUndefinedClassMember(UE_UPackage::Member& member) {
     // ޸ṹһЩûֵĽṹֱchar
-    member.Type = "/*" + member.Type + "*/" + "char";
-    member.Name += fmt::format("[{:#0x}]", member.Size);
+    member.Type = TypeTable::Opaque(member.Type);
+    member.Name = StringPool::Intern(fmt::format("{}[{:#0x}]", StringPool::Get(member.Name), member.Size));
   }
 
-  static bool CanIgnoreRef(std::string typeName) {
+  static bool CanIgnoreRef(TypeRef type) {
     // suppose that all template can be ignored.
     // printf("Judge ignore: %s\n", typeName.c_str());
     return true;
@@ -217,141 +234,69 @@ class RefGraphSolver
     // 洢ͣȥ
     std::set<std::string> refTypes;
 
-    // 洢packageȥ
-    std::set <std::string> refPackages;
+    // 洢package
+    std::vector<int32> refPackages;
+
+    // includes and declarations of the package header
+    PackageRefs refs;
 
-    auto processStruct = [&refTypes, &refPackages, &packageName](UE_UPackage::Struct& klass) {
+    auto processStruct = [&refTypes, &refPackages, &refs, &packageName](UE_UPackage::Struct& klass) {
       
       // ̳
-      auto& superName = klass.SuperName;
+      std::string superName(StringPool::Get(klass.SuperName));
       if (superName == "FNone" && verboseDebug) {
         // printf("EmptySuperClass: %s\n", klass.ClassName.c_str());
       }
       assert(superName.find("<") == std::string::npos);  // Should not be possible?
-      if (superName != "FNone" && superName != "") refTypes.insert(superName);
+      if (superName != "FNone" && superName != "") {
+        refTypes.insert(superName);
+        auto it = typeDefMap.find(superName);
+        if (it != typeDefMap.end()) refs.includes.push_back(it->second);
+      }
 
       // Ա
       for (auto& member : klass.Members) {
-        auto purename = GetPureTypeName(member.Type);
-        if (purename.find("<") != std::string::npos) {
-          // generic type
-          auto genericTypes = GetGenericTypes(purename);
-          bool should_fix = false;
-          for (auto& tname : genericTypes) {
-            assert(tname != "");
-            if (typeDefMap.count(tname) == 0) {
-              should_fix = true;
-              FixUndefinedClassMember(member);
-              break;
-            }
-          }
-          if (!should_fix && ignoreTemplateRef && CanIgnoreRef(purename)) {
-            continue;
-          }
-          if(!should_fix)
-            for (auto& tname : genericTypes) {
-              assert(tname != "");
-              refTypes.insert(tname);
-            }
-        }
-        else {
-          assert(purename != "");
-          if (typeDefMap.count(purename) == 0)
-            FixUndefinedClassMember(member);
-          else
-            refTypes.insert(purename);
+        if (!IsTypeDefined(member.Type)) {
+          FixUndefinedClassMember(member);
+          continue;
         }
+        AddIncludeRefs(member.Type, refs);
+        if (IsTemplate(member.Type) && ignoreTemplateRef && CanIgnoreRef(member.Type)) continue;
+        AddTypePackages(member.Type, refPackages);
       }
       // 
       for (auto& function : klass.Functions) {
         // ֵ
-        bool deleteFunction = false; // ֵ⣬Ǿóvoid
-        auto purename = GetPureTypeName(function.RetType);
-        if (purename.find("<") != std::string::npos) {
-          // generic type
-          auto genericTypes = GetGenericTypes(purename);
-          bool should_fix = false;
-          for (auto& tname : genericTypes) {
-            assert(tname != "");
-            if (typeDefMap.count(tname) == 0) {
-              should_fix = true;
-              function.RetType = "void";
-              function.CppName = "void " + function.FuncName;
-              function.paramInfo.clear();
-              break;
-            }
-          }
-          if (!should_fix && ignoreTemplateRef && CanIgnoreRef(purename)) {
-            goto paramProcess;
-          }
-          if(!should_fix)
-            for (auto& tname : genericTypes) {
-              assert(tname != "");
-              refTypes.insert(tname);
-            }
+        if (!IsTypeDefined(function.RetType)) {
+          // ֵ⣬Ǿóvoid
+          function.RetType = TypeTable::Void;
+          function.emptyParamStruct = true;
         }
-        else {
-          assert(purename != "");
-          if (typeDefMap.count(purename) == 0) {
-            function.RetType = "void";
-            function.CppName = "void " + function.FuncName;
-            function.paramInfo.clear();
-          }
-          else {
-            refTypes.insert(purename);
-          }
+        else if (!(IsTemplate(function.RetType) && ignoreTemplateRef && CanIgnoreRef(function.RetType))) {
+          AddTypePackages(function.RetType, refPackages);
         }
-        paramProcess:;
         // 
-        for (auto paramtype : function.ParamTypes) {
-          auto purename = GetPureTypeName(paramtype);
-          if (purename.find("<") != std::string::npos) {
-            // generic type
-            auto genericTypes = GetGenericTypes(purename);
-            bool should_fix = false;
-            for (auto& tname : genericTypes) {
-              assert(tname != "");
-              if (typeDefMap.count(tname) == 0) {
-                should_fix = true;
-                function.Params = "/*" + function.Params + "*/";
-                function.paramInfo.clear();
-                function.ParamTypes.clear();
-                function.badDeclareFunc = true;
-                goto end;
-              }
-            }
-            if (!should_fix && ignoreTemplateRef && CanIgnoreRef(purename)) {
-              continue;
-            }
-            if(!should_fix)
-              for (auto& tname : genericTypes) {
-                assert(tname != "");
-                refTypes.insert(tname);
-              }
+        for (auto paramType : function.ParamTypes) {
+          if (!IsTypeDefined(paramType)) {
+            function.ParamTypes.clear();
+            function.badDeclareFunc = true;
+            break;
+          }
+          auto& type = TypeTable::Get(paramType);
+          if (type.Kind == TypeKind::Template) {
+            if (ignoreTemplateRef && CanIgnoreRef(paramType)) continue;
           }
           else {
-            assert(purename != "");
-            if (typeDefMap.count(purename) == 0) {
-              function.Params = "/*" + function.Params + "*/";
-              function.paramInfo.clear();
-              function.ParamTypes.clear();
-              function.badDeclareFunc = true;
-              goto end;
-            }
-            else {
-              auto isEnumType = [](std::string& type) {
-                if (type.size() <= 4) return false;
-                if (type.substr(0, 4) == "enum") return true;
-                return false;
-              };
-              // ָֻſԺ
-              if (ignoreFuncParamRef && !isEnumType(paramtype) && paramtype.find("*") != std::string::npos) continue;
-              // printf("insert  %s\n", purename.c_str());
-              refTypes.insert(purename);
-            }
+            // ָֻſԺ
+            if (ignoreFuncParamRef && type.Keyword != TypeKeyword::EnumClass && type.Pointer) continue;
           }
+          AddTypePackages(paramType, refPackages);
+        }
+        // parameter structs hold their members by value
+        AddIncludeRefs(function.RetType, refs);
+        for (auto paramType : function.ParamTypes) {
+          AddIncludeRefs(paramType, refs);
         }
-        end:;
       }
     };
 
@@ -369,13 +314,25 @@ class RefGraphSolver
         printf("[Warning] Cannot find type \"%s\" in any package!\n", refType.c_str());
         continue;
       }
-      refPackages.insert(typeDefMap[refType]);
+      refPackages.push_back(typeDefMap[refType]);
     }
 
+    // ȥ, edges are added in package name order
+    std::sort(refPackages.begin(), refPackages.end(), [](int32 a, int32 b) { return packageNames[a] < packageNames[b]; });
+    refPackages.erase(std::unique(refPackages.begin(), refPackages.end()), refPackages.end());
+
+    auto it = packageIds.find(packageName);
+    if (it != packageIds.end()) packageRefs[it->second] = std::move(refs);
+
     // ӹϵ
-    for(auto& targetPackage : refPackages) {
-      if (packageName == targetPackage) continue;
-      AddEdge(packageName, targetPackage);
+    if (refPackages.empty()) return;
+    if (it == packageIds.end()) {
+      printf("Could not found Referer class node \"%s\"!", packageName.c_str());
+      return;
+    }
+    for (auto targetPackage : refPackages) {
+      if (packageName == packageNames[targetPackage]) continue;
+      AddEdge(it->second, targetPackage);
     }
   }
 
@@ -392,239 +349,241 @@ class RefGraphSolver
     /// DEBUG!!!
     // if (packageName != "Engine") return;
 
-    // inclassTypeName -> Node*
-    std::unordered_map<std::string, Node*> classMp, structMp;
-    std::unordered_map<std::string, int> typeMap; // ֵstructclass
-
-    auto isTypeInCurrentPackage = [&packageName](std::string typeName) {
-      if (typeDefMap.count(typeName) == 0) return false;
-      return typeDefMap[typeName] == packageName;
-    };
-
-    auto insertEdge = [&typeMap](std::string referer, std::string referee, std::unordered_map<std::string, Node*>& nodeMp) {
-      if (typeMap[referer] != typeMap[referee]) return;  // class -> struct, struct -> class ûҪ
-      if (referer == referee) return; // Ի
-      Node* per, * pee;
-      if (nodeMp.count(referer)) {
-        per = nodeMp[referer];
-      }
-      else {
-        per = new Node(referer);
-        nodeMp[referer] = per;
+    // ֵstructclass, types of other packages have no position
+    auto place = [](int kind, std::vector<UE_UPackage::Struct>& classes) {
+      for (int32 i = 0; i < (int32)classes.size(); i++) {
+        auto index = classes[i].Index;
+        if (index < 0) continue;
+        if (index >= (int32)typePositions.size()) typePositions.resize(index + 1, { 0, -1 });
+        typePositions[index] = { kind, i };
       }
-      if (nodeMp.count(referee)) {
-        pee = nodeMp[referee];
-      }
-      else {
-        pee = new Node(referee);
-        nodeMp[referee] = pee;
-      }
-      pee->outdeg++;
-      per->indeg++;
-      pee->neighbors.push_back(per);
-      // if (verboseDebug) printf("SelfAddEdge %s -> %s\n", referer.c_str(), referee.c_str());
     };
+    place(1, package.Classes);
+    place(2, package.Structures);
+
+    auto processStruct = [&](int kind, int32 referer, Graph& graph, std::vector<bool>& linked) {
+      auto& klass = kind == 1 ? package.Classes[referer] : package.Structures[referer];
+      auto insertEdge = [&](int32 referee) {
+        if (referee < 0 || referee >= (int32)typePositions.size()) return;
+        auto position = typePositions[referee];
+        if (position.first != kind) return;  // class -> struct, struct -> class ûҪ
+        if (position.second == referer) return; // Ի
+        graph.AddEdge(referer, position.second);
+        linked[referer] = true;
+        linked[position.second] = true;
+      };
 
-    auto processStruct = [&isTypeInCurrentPackage, &insertEdge](UE_UPackage::Struct& klass, std::unordered_map<std::string, Node*>& mp) {
-      if (klass.ClassName == "FALSAnimRotateInPlace") {
-        // _CrtDbgBreak();
-      }
       // ̳
-      auto& superName = klass.SuperName;
-      assert(superName.find("<") == std::string::npos);  // Should not be possible?
-      if (superName != "FNone" && superName != "" && isTypeInCurrentPackage(superName)) {
-        insertEdge(klass.ClassName, superName, mp);
-      }
+      insertEdge(klass.SuperIndex);
 
       // Ա
       for (auto& member : klass.Members) {
-        if (member.Type.find("*") != std::string::npos) {
-          // class pointre, can be ignored
-          continue;
-        }
-        auto purename = GetPureTypeName(member.Type);
-        if (purename.find("<") != std::string::npos) {
-          // generic type
-          auto genericTypes = GetGenericTypes(purename);
-          if (ignoreTemplateRef && CanIgnoreRef(purename)) {
-            continue;
-          }
-          for (auto& tname : genericTypes) {
-            assert(tname != "");
-            if (isTypeInCurrentPackage(tname)) insertEdge(klass.ClassName, tname, mp);
-          }
-        }
-        else {
-          assert(purename != "");
-          if (isTypeInCurrentPackage(purename)) insertEdge(klass.ClassName, purename, mp);
-        }
+        // class pointer or unresolved member, can be ignored
+        if (TypeTable::Get(member.Type).Kind == TypeKind::Opaque || TypeTable::HasPointer(member.Type)) continue;
+        if (IsTemplate(member.Type) && ignoreTemplateRef && CanIgnoreRef(member.Type)) continue;
+        TypeTable::ForEach(member.Type, [&](const TypeNode& node) { insertEdge(node.Ref); });
       }
 
       // 
       for (auto& function : klass.Functions) {
         // ֵ
-        if(function.RetType.find("*") == std::string::npos){
-          auto purename = GetPureTypeName(function.RetType);
-          if (purename.find("<") != std::string::npos) {
-            // generic type
-            auto genericTypes = GetGenericTypes(purename);
-            if (ignoreTemplateRef && CanIgnoreRef(purename)) {
-              continue;
-            }
-            for (auto& tname : genericTypes) {
-              assert(tname != "");
-              if (isTypeInCurrentPackage(tname)) insertEdge(klass.ClassName, tname, mp);
-            }
-          }
-          else {
-            assert(purename != "");
-            if (isTypeInCurrentPackage(purename)) insertEdge(klass.ClassName, purename, mp);
-          }
+        if (!TypeTable::HasPointer(function.RetType)) {
+          if (IsTemplate(function.RetType) && ignoreTemplateRef && CanIgnoreRef(function.RetType)) continue;
+          TypeTable::ForEach(function.RetType, [&](const TypeNode& node) { insertEdge(node.Ref); });
         }
         // 
-        for (auto paramtype : function.ParamTypes) {
-          auto purename = GetPureTypeName(paramtype);
-          if (purename.find("<") != std::string::npos) {
-            // generic type
-            auto genericTypes = GetGenericTypes(purename);
-            if (ignoreTemplateRef && CanIgnoreRef(purename)) {
-              continue;
-            }
-            for (auto& tname : genericTypes) {
-              assert(tname != "");
-              if (isTypeInCurrentPackage(tname)) insertEdge(klass.ClassName, tname, mp);
-            }
-          }
-          else {
-            assert(purename != "");
-            if (ignoreFuncParamRef) continue;
-            if (isTypeInCurrentPackage(purename)) insertEdge(klass.ClassName, purename, mp);
-          }
+        for (auto paramType : function.ParamTypes) {
+          if (IsTemplate(paramType) ? ignoreTemplateRef && CanIgnoreRef(paramType) : ignoreFuncParamRef) continue;
+          TypeTable::ForEach(paramType, [&](const TypeNode& node) { insertEdge(node.Ref); });
         }
       }
     };
 
-    auto inclassTopo = [&packageName](std::vector<UE_UPackage::Struct>& classes, std::unordered_map<std::string, Node*>& mp) {
-      std::vector<UE_UPackage::Struct> newOrder;
-      std::unordered_map<std::string, UE_UPackage::Struct> mp2;
-      std::unordered_map<std::string, bool> debug;
-      std::queue<Node*> queue;
-      for (auto& klass : classes) {
-        mp2[klass.ClassName] = klass;
-        // ûԼϵȷŽȥ
-        if (mp.count(klass.ClassName) == 0) {
-          newOrder.push_back(klass);
-          debug[klass.ClassName] = true;
-        }
-        else {
-          if (mp[klass.ClassName]->indeg == 0) {
-            queue.push(mp[klass.ClassName]);
-          }
-        }
+    auto inclassTopo = [&](int kind, std::vector<UE_UPackage::Struct>& classes) {
+      Graph graph;
+      std::vector<bool> linked(classes.size(), false);
+      // ҳ
+      for (int32 i = 0; i < (int32)classes.size(); i++) {
+        processStruct(kind, i, graph, linked);
       }
-      while (!queue.empty()) {
-        Node* front = queue.front();
-        debug[front->packageName] = true;
-        newOrder.push_back(mp2[front->packageName]);
-        queue.pop();
-        for (auto other : front->neighbors) {
-          other->indeg--;
-          if (other->indeg == 0) queue.push(other);
-        }
+
+      // ûԼϵȷŽȥ
+      std::vector<int32> newOrder, seeds;
+      for (int32 i = 0; i < (int32)classes.size(); i++) {
+        if (linked[i]) seeds.push_back(i);
+        else newOrder.push_back(i);
       }
-      for (auto& ori : classes) {
-        if (debug.count(ori.ClassName) == 0) {
-          printf("[disappear][%s] %s\n", packageName.c_str(), ori.ClassName.c_str());
+      auto sorted = graph.Sort((int32)classes.size(), seeds);
+      newOrder.insert(newOrder.end(), sorted.begin(), sorted.end());
+
+      if (newOrder.size() != classes.size()) {
+        std::vector<bool> placed(classes.size(), false);
+        for (auto i : newOrder) placed[i] = true;
+        for (int32 i = 0; i < (int32)classes.size(); i++) {
+          if (!placed[i]) printf("[disappear][%s] %s\n", packageName.c_str(), classes[i].ClassName.c_str());
         }
       }
       assert(newOrder.size() == classes.size());
-      classes = newOrder;
+
+      // the structs are only moved once the order is known
+      std::vector<UE_UPackage::Struct> ordered;
+      ordered.reserve(newOrder.size());
+      for (auto i : newOrder) {
+        ordered.push_back(std::move(classes[i]));
+      }
+      classes = std::move(ordered);
     };
+    inclassTopo(1, package.Classes);
+    inclassTopo(2, package.Structures);
+
+    // the positions only hold for this package, the next one starts from a clean table
     for (auto& klass : package.Classes) {
-      typeMap[klass.ClassName] = 1;
+      if (klass.Index >= 0) typePositions[klass.Index] = { 0, -1 };
     }
     for (auto& klass : package.Structures) {
-      typeMap[klass.ClassName] = 2;
+      if (klass.Index >= 0) typePositions[klass.Index] = { 0, -1 };
     }
+  }
 
-    // ҳ
-    for (auto& klass : package.Classes) {
-      processStruct(klass, classMp);
+  // Transitive reduction of the includes: a package that is already included through
+  // another include is dropped, so is a declaration of a type that an include brings
+  // in. The includes are sorted on their own since packageGraph has no edges for
+  // template arguments. An include comes before its includers in 'order', so its reach
+  // is known when it is used.
+  static void ReduceIncludes() {
+    size_t count = packageNames.size();
+    Graph includeGraph;
+    std::vector<int32> all(count);
+    for (int32 node = 0; node < (int32)count; node++) {
+      all[node] = node;
+      auto& includes = packageRefs[node].includes;
+      includes.erase(std::remove(includes.begin(), includes.end(), node), includes.end());
+      std::sort(includes.begin(), includes.end(), [](int32 a, int32 b) { return packageNames[a] < packageNames[b]; });
+      includes.erase(std::unique(includes.begin(), includes.end()), includes.end());
+      for (auto include : includes) includeGraph.AddEdge(node, include);
     }
-    for (auto& klass : package.Structures) {
-      processStruct(klass, structMp);
+    auto order = includeGraph.Sort((int32)count, all);
+
+    size_t words = (count + 63) / 64;
+    std::vector<uint64> reach(count * words, 0);
+    auto reaches = [&](int32 from, int32 to) {
+      return (reach[from * words + to / 64] >> (to % 64)) & 1;
+    };
+
+    // packages on a cycle are not in 'order', they keep all of their includes
+    std::vector<int32> nodes(order);
+    std::vector<bool> placed(count, false);
+    for (auto node : order) placed[node] = true;
+    for (int32 i = 0; i < (int32)count; i++) {
+      if (!placed[i]) nodes.push_back(i);
     }
-    inclassTopo(package.Classes, classMp);
-    inclassTopo(package.Structures, structMp);
-  }
 
-  static void TopoSort() {
-    std::queue<Node*> queue;
-    for (Node* node : packageNodes) {
-      if (node->indeg == 0) {
-        // ʾģѾģˣ
-        queue.push(node);
+    for (auto node : nodes) {
+      auto& refs = packageRefs[node];
+      auto& includes = refs.includes;
+      auto row = &reach[node * words];
+      for (auto include : includes) {
+        auto includeRow = &reach[include * words];
+        for (size_t i = 0; i < words; i++) row[i] |= includeRow[i];
+        row[include / 64] |= 1ull << (include % 64);
       }
+      std::vector<int32> direct(includes);
+      includes.erase(std::remove_if(includes.begin(), includes.end(), [&](int32 include) {
+        for (auto other : direct) {
+          if (other != include && reaches(other, include)) return true;
+        }
+        return false;
+      }), includes.end());
+
+      auto& declares = refs.declares;
+      declares.erase(std::remove_if(declares.begin(), declares.end(), [&](const std::pair<int32, std::string>& declare) {
+        return declare.first == node || (declare.first >= 0 && reaches(node, declare.first));
+      }), declares.end());
+      std::sort(declares.begin(), declares.end(), [](const std::pair<int32, std::string>& a, const std::pair<int32, std::string>& b) {
+        return a.second < b.second;
+      });
+      declares.erase(std::unique(declares.begin(), declares.end()), declares.end());
     }
-    int cnt = 0;
-    while (!queue.empty()) {
-      Node* front = queue.front();
-      queue.pop();
-      cnt++;
-      // if(verboseDebug) printf("package[%d]: %s\n", cnt, front->packageName.c_str());
-      packageHeaderOrder.push_back(front->packageName);
-      for (auto other : front->neighbors) {
-        other->indeg--;
-        if (other->indeg == 0) queue.push(other);
-      }
+  }
+
+  static void TopoSort() {
+    // ʾģѾģˣ
+    std::vector<int32> nodes(packageNames.size());
+    for (int32 i = 0; i < (int32)nodes.size(); i++) nodes[i] = i;
+    auto order = packageGraph.Sort((int32)nodes.size(), nodes);
+    ReduceIncludes();
+    for (auto node : order) {
+      // if(verboseDebug) printf("package[%d]: %s\n", cnt, packageNames[node].c_str());
+      packageHeaderOrder.push_back(packageNames[node]);
     }
-    if (cnt != packageNodes.size()) {
+    if (order.size() != nodes.size()) {
       printf("[Warning] Not all packages are included in the header for the reference problem. \n");
-      for (Node* node : packageNodes) {
-        if (node->indeg != 0) {
-          printf("\tPackageName: %s\n", node->packageName.c_str());
+      std::vector<bool> placed(nodes.size(), false);
+      for (auto node : order) placed[node] = true;
+      for (auto node : nodes) {
+        if (!placed[node]) {
+          printf("\tPackageName: %s\n", packageNames[node].c_str());
         }
       }
     }
   }
 
 public:
-  static void Process(std::vector<UE_UPackage>& packages) {
-    LoadUnrealPackageDef();
+  // Names the packages after their objects, suffixing names that repeat
+  static void NamePackages(std::vector<UE_UPackage>& packages) {
     std::unordered_map<std::string, int> packageNameMp;
     for (UE_UPackage& package : packages) {
-      package.packageName = package.GetObject().GetName();
+      package.packageName = ObjTable.GetName(ObjTable.IndexOf(package.GetObject()));
       if (packageNameMp.count(package.packageName) > 0) {
         package.packageName += fmt::format("_{}", ++packageNameMp[package.packageName]);
       }
       else {
         packageNameMp[package.packageName] = 1;
       }
-      LoadPackageDef(package);
-    }
-
-    if (verboseDebug) {
-      printf("\nLoaded all packages defs! \n");
     }
+  }
 
+  // Records where every declared type is defined,
+  // a package can be solved as soon as it is generated afterwards
+  static void LoadPackages(std::vector<UE_UPackage>& packages) {
+    LoadUnrealPackageDef();
     for (UE_UPackage& package : packages) {
-      BuildRefGraph(package);
+      LoadPackageDef(package);
     }
 
     if (verboseDebug) {
-      printf("\nReference graph builded! \n");
+      printf("\nLoaded all packages defs! \n");
     }
+  }
 
+  // Resolves the references of a generated package and orders its types
+  static void SolvePackage(UE_UPackage& package) {
+    BuildRefGraph(package);
+    FixPackageTypeOrder(package);
+  }
 
-    // ڵϵ
-    fmt::print("Fixing package type order... \n");
-    for (UE_UPackage& package : packages) {
-      FixPackageTypeOrder(package);
-    }
-
+  // Orders the package headers once every package is solved
+  static void SortPackages() {
     TopoSort();
   }
 
+  // Packages the header of a package includes and the types it declares, after SortPackages
+  static void GetPackageRefs(const std::string& packageName, std::vector<std::string>& includes, std::vector<std::string>& declares) {
+    auto it = packageIds.find(packageName);
+    if (it == packageIds.end()) return;
+    auto& refs = packageRefs[it->second];
+    // BasicTypes brings the standard headers the c++ types come from, every header
+    // starts with it so it can be used on its own
+    includes.push_back("BasicTypes");
+    for (auto include : refs.includes) {
+      if (packageNames[include] == "CppTypes" || packageNames[include] == "BasicTypes") continue;
+      includes.push_back(packageNames[include]);
+    }
+    for (auto& declare : refs.declares) {
+      declares.push_back(declare.second);
+    }
+  }
+
   static std::vector<std::string> packageHeaderOrder;
 
 };
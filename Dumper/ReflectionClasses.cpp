@@ -0,0 +1,98 @@
+#include <unordered_map>
+#include <unordered_set>
+#include "ReflectionClasses.h"
+
+UE_UClass ReflectionClasses::Object;
+UE_UClass ReflectionClasses::Actor;
+UE_UClass ReflectionClasses::Field;
+UE_UClass ReflectionClasses::Property;
+UE_UClass ReflectionClasses::Struct;
+UE_UClass ReflectionClasses::Function;
+UE_UClass ReflectionClasses::ScriptStruct;
+UE_UClass ReflectionClasses::Class;
+UE_UClass ReflectionClasses::Enum;
+UE_UClass ReflectionClasses::DoubleProperty;
+UE_UClass ReflectionClasses::StructProperty;
+UE_UClass ReflectionClasses::NameProperty;
+UE_UClass ReflectionClasses::ObjectPropertyBase;
+UE_UClass ReflectionClasses::ArrayProperty;
+UE_UClass ReflectionClasses::ByteProperty;
+UE_UClass ReflectionClasses::BoolProperty;
+UE_UClass ReflectionClasses::FloatProperty;
+UE_UClass ReflectionClasses::IntProperty;
+UE_UClass ReflectionClasses::Int16Property;
+UE_UClass ReflectionClasses::Int64Property;
+UE_UClass ReflectionClasses::Int8Property;
+UE_UClass ReflectionClasses::UInt16Property;
+UE_UClass ReflectionClasses::UInt32Property;
+UE_UClass ReflectionClasses::UInt64Property;
+UE_UClass ReflectionClasses::TextProperty;
+UE_UClass ReflectionClasses::StrProperty;
+UE_UClass ReflectionClasses::EnumProperty;
+UE_UClass ReflectionClasses::ClassProperty;
+UE_UClass ReflectionClasses::SetProperty;
+UE_UClass ReflectionClasses::MapProperty;
+UE_UClass ReflectionClasses::InterfaceProperty;
+UE_UClass ReflectionClasses::MulticastDelegateProperty;
+UE_UClass ReflectionClasses::WeakObjectProperty;
+UE_UClass ReflectionClasses::LazyObjectProperty;
+UE_UClass ReflectionClasses::SoftObjectProperty;
+UE_UClass ReflectionClasses::SoftClassProperty;
+
+void ReflectionClasses::Resolve() {
+  std::unordered_map<std::string, UE_UClass*> classMp = {
+    { "Class CoreUObject.Object", &Object },
+    { "Class Engine.Actor", &Actor },
+    { "Class CoreUObject.Field", &Field },
+    { "Class CoreUObject.Property", &Property },
+    { "Class CoreUObject.Struct", &Struct },
+    { "Class CoreUObject.Function", &Function },
+    { "Class CoreUObject.ScriptStruct", &ScriptStruct },
+    { "Class CoreUObject.Class", &Class },
+    { "Class CoreUObject.Enum", &Enum },
+    { "Class CoreUObject.DoubleProperty", &DoubleProperty },
+    { "Class CoreUObject.StructProperty", &StructProperty },
+    { "Class CoreUObject.NameProperty", &NameProperty },
+    { "Class CoreUObject.ObjectPropertyBase", &ObjectPropertyBase },
+    { "Class CoreUObject.ArrayProperty", &ArrayProperty },
+    { "Class CoreUObject.ByteProperty", &ByteProperty },
+    { "Class CoreUObject.BoolProperty", &BoolProperty },
+    { "Class CoreUObject.FloatProperty", &FloatProperty },
+    { "Class CoreUObject.IntProperty", &IntProperty },
+    { "Class CoreUObject.Int16Property", &Int16Property },
+    { "Class CoreUObject.Int64Property", &Int64Property },
+    { "Class CoreUObject.Int8Property", &Int8Property },
+    { "Class CoreUObject.UInt16Property", &UInt16Property },
+    { "Class CoreUObject.UInt32Property", &UInt32Property },
+    { "Class CoreUObject.UInt64Property", &UInt64Property },
+    { "Class CoreUObject.TextProperty", &TextProperty },
+    { "Class CoreUObject.StrProperty", &StrProperty },
+    { "Class CoreUObject.EnumProperty", &EnumProperty },
+    { "Class CoreUObject.ClassProperty", &ClassProperty },
+    { "Class CoreUObject.SetProperty", &SetProperty },
+    { "Class CoreUObject.MapProperty", &MapProperty },
+    { "Class CoreUObject.InterfaceProperty", &InterfaceProperty },
+    { "Class CoreUObject.MulticastDelegateProperty", &MulticastDelegateProperty },
+    { "Class CoreUObject.WeakObjectProperty", &WeakObjectProperty },
+    { "Class CoreUObject.LazyObjectProperty", &LazyObjectProperty },
+    { "Class CoreUObject.SoftObjectProperty", &SoftObjectProperty },
+    { "Class CoreUObject.SoftClassProperty", &SoftClassProperty },
+  };
+
+  // object names are compared first, the full name is only built for candidates
+  std::unordered_set<std::string> names;
+  for (auto& [fullName, cls] : classMp) {
+    *cls = nullptr;
+    names.insert(fullName.substr(fullName.rfind('.') + 1));
+  }
+
+  auto left = classMp.size();
+  for (uint32 i = 0; i < ObjObjects.NumElements && left; i++) {
+    UE_UObject object = ObjObjects.GetObjectPtr(i);
+    if (!object || !names.count(object.GetName())) continue;
+    auto it = classMp.find(object.GetFullName());
+    if (it == classMp.end() || *it->second) continue;
+    *it->second = object.Cast<UE_UClass>();
+    left--;
+  }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "wrappers.h"
+
+// Core reflection classes the wrappers compare objects against.
+// Resolve looks all of them up in a single pass over GUObjectArray at EngineInit,
+// StaticClass() of every wrapper then returns the resolved pointer.
+// A class the game does not have (e.g. UProperty classes since 4.25) stays nullptr.
+struct ReflectionClasses {
+  static UE_UClass Object;
+  static UE_UClass Actor;
+  static UE_UClass Field;
+  static UE_UClass Property;
+  static UE_UClass Struct;
+  static UE_UClass Function;
+  static UE_UClass ScriptStruct;
+  static UE_UClass Class;
+  static UE_UClass Enum;
+  static UE_UClass DoubleProperty;
+  static UE_UClass StructProperty;
+  static UE_UClass NameProperty;
+  static UE_UClass ObjectPropertyBase;
+  static UE_UClass ArrayProperty;
+  static UE_UClass ByteProperty;
+  static UE_UClass BoolProperty;
+  static UE_UClass FloatProperty;
+  static UE_UClass IntProperty;
+  static UE_UClass Int16Property;
+  static UE_UClass Int64Property;
+  static UE_UClass Int8Property;
+  static UE_UClass UInt16Property;
+  static UE_UClass UInt32Property;
+  static UE_UClass UInt64Property;
+  static UE_UClass TextProperty;
+  static UE_UClass StrProperty;
+  static UE_UClass EnumProperty;
+  static UE_UClass ClassProperty;
+  static UE_UClass SetProperty;
+  static UE_UClass MapProperty;
+  static UE_UClass InterfaceProperty;
+  static UE_UClass MulticastDelegateProperty;
+  static UE_UClass WeakObjectProperty;
+  static UE_UClass LazyObjectProperty;
+  static UE_UClass SoftObjectProperty;
+  static UE_UClass SoftClassProperty;
+
+  static void Resolve();
+};
@@ -0,0 +1,59 @@
+#include <cstring>
+#include "SignatureScan.h"
+
+// How often a byte shows up in x64 code, higher is more common. Anchoring on rare bytes
+// keeps the number of candidates that need a full compare low.
+static uint8 Commonness(uint8 byte) {
+  switch (byte) {
+  case 0x00: case 0xFF: case 0xCC: case 0x48: return 10;
+  case 0x8B: case 0x89: case 0x0F: case 0xE8: case 0x24: return 8;
+  case 0x4C: case 0x44: case 0x85: case 0x83: case 0xC0: case 0x8D: case 0x74: return 7;
+  case 0x75: case 0x01: case 0x45: case 0x41: case 0x49: case 0x33: case 0xC3: case 0x90: case 0x40: return 6;
+  case 0x20: case 0x08: case 0x10: case 0x28: case 0x30: case 0x38: case 0x50: case 0x5C: return 5;
+  case 0xE9: case 0xEB: case 0x4D: case 0xC7: case 0x84: case 0x8A: case 0xC1: case 0x18: return 4;
+  default: return byte < 0x10 ? 3 : 0;
+  }
+}
+
+SignaturePattern::SignaturePattern(const char* sig, uint32 size) : Sig((const uint8*)sig), Size(size), First(size), Second(size) {
+  for (uint32 i = 0; i < size; i++) {
+    if (!Sig[i]) continue;
+    auto rank = Commonness(Sig[i]);
+    if (First == size || rank < Commonness(Sig[First])) {
+      Second = First;
+      First = i;
+    } else if (Second == size || rank < Commonness(Sig[Second])) {
+      Second = i;
+    }
+  }
+  if (Second == size) Second = First;
+}
+
+bool SignaturePattern::Matches(const uint8* data) const {
+  for (uint32 i = 0; i < Size; i++) {
+    if (data[i] != Sig[i] && Sig[i] != 0x00) return false;
+  }
+  return true;
+}
+
+uint8* ScanSignature(void* start, void* end, const char* sig, uint32 size) {
+  auto it = (uint8*)start;
+  auto stop = (uint8*)end;
+  if (stop - it <= (int64)size) return nullptr;
+  auto last = stop - size; // candidates are [start, last)
+
+  SignaturePattern pattern(sig, size);
+  // nothing to anchor on, every position matches
+  if (pattern.First == size) return it;
+
+  auto anchor = pattern.Sig[pattern.First];
+  auto second = pattern.Sig[pattern.Second];
+  while (it < last) {
+    auto hit = (uint8*)memchr(it + pattern.First, anchor, last - it);
+    if (!hit) return nullptr;
+    auto candidate = hit - pattern.First;
+    if (candidate[pattern.Second] == second && pattern.Matches(candidate)) return candidate;
+    it = candidate + 1;
+  }
+  return nullptr;
+}
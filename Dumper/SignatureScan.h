@@ -0,0 +1,20 @@
+#pragma once
+#include "defs.h"
+
+// Signature with the offsets of its two rarest bytes, 0x00 in the signature matches any byte
+struct SignaturePattern {
+  const uint8* Sig;
+  uint32 Size;
+  uint32 First;  // offset of the rarest byte, Size if every byte is a wildcard
+  uint32 Second; // offset of the next rarest one, same as First for a single byte
+
+  SignaturePattern(const char* sig, uint32 size);
+  bool Matches(const uint8* data) const;
+};
+
+// Address of the first match of the signature in [start, end - size). The scan jumps
+// between occurrences of the rarest byte with memchr and only compares the positions
+// where the next rarest byte matches as well. memchr is vectorized by the runtime and
+// the scan is bound by memory bandwidth, SSE2/AVX2 loops were not faster
+// (tools/SignatureScanBench.cpp).
+uint8* ScanSignature(void* start, void* end, const char* sig, uint32 size);
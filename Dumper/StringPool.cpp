@@ -0,0 +1,37 @@
+#include <cstring>
+#include "StringPool.h"
+
+std::mutex StringPool::lock;
+ChunkedArray<std::string_view> StringPool::strings = { std::string_view() };
+std::unordered_map<std::string_view, StringRef> StringPool::stringMp = { { std::string_view(), 0 } };
+std::vector<std::unique_ptr<char[]>> StringPool::blocks;
+char* StringPool::cursor = nullptr;
+size_t StringPool::left = 0;
+
+std::string_view StringPool::Store(std::string_view str) {
+  char* data;
+  if (str.size() > BlockSize / 4) {
+    // long strings get a block of their own, the current one keeps filling up
+    data = blocks.emplace_back(new char[str.size()]).get();
+  } else {
+    if (str.size() > left) {
+      cursor = blocks.emplace_back(new char[BlockSize]).get();
+      left = BlockSize;
+    }
+    data = cursor;
+    cursor += str.size();
+    left -= str.size();
+  }
+  memcpy(data, str.data(), str.size());
+  return std::string_view(data, str.size());
+}
+
+StringRef StringPool::Intern(std::string_view str) {
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = stringMp.find(str);
+  if (it != stringMp.end()) return it->second;
+  auto stored = Store(str);
+  StringRef id = strings.PushBack(stored);
+  stringMp[stored] = id;
+  return id;
+}
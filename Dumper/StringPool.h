@@ -0,0 +1,35 @@
+#pragma once
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "defs.h"
+#include "ChunkedArray.h"
+
+// Id of an interned string, equal strings always get the same id.
+// 0 is the empty string.
+typedef uint32 StringRef;
+
+// Strings that repeat across the generated types (member and parameter names,
+// function flags, super class names) are stored once for the whole dump.
+// Characters live in large blocks that are never freed, so views stay valid.
+// Get takes no lock, only interning a new string does.
+class StringPool {
+  static constexpr size_t BlockSize = 0x10000;
+
+  static std::mutex lock; // taken by Intern only
+  static ChunkedArray<std::string_view> strings;
+  static std::unordered_map<std::string_view, StringRef> stringMp;
+  static std::vector<std::unique_ptr<char[]>> blocks;
+  static char* cursor; // free space of the current block
+  static size_t left;
+
+  static std::string_view Store(std::string_view str);
+
+  friend class PackageIR;
+
+public:
+  static StringRef Intern(std::string_view str);
+  static std::string_view Get(StringRef id) { return strings[id]; }
+};
@@ -0,0 +1,95 @@
+#include "TaskPool.h"
+
+TaskPool::~TaskPool() {
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stop = true;
+  }
+  wake.notify_all();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void TaskPool::Start(uint32 count) {
+  if (threads.size() || count < 2) return;
+  queueCount = count;
+  queues.reset(new Queue[count]);
+  for (uint32 i = 0; i < count - 1; i++) {
+    threads.emplace_back(&TaskPool::WorkerLoop, this, i);
+  }
+}
+
+bool TaskPool::Pop(uint32 id, uint32& task) {
+  auto& queue = queues[id];
+  std::lock_guard<std::mutex> guard(queue.lock);
+  if (queue.tasks.empty()) return false;
+  task = queue.tasks.front();
+  queue.tasks.pop_front();
+  return true;
+}
+
+bool TaskPool::Steal(uint32 id, uint32& task) {
+  for (uint32 i = 1; i < queueCount; i++) {
+    auto& queue = queues[(id + i) % queueCount];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.tasks.empty()) continue;
+    task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return true;
+  }
+  return false;
+}
+
+void TaskPool::Drain(uint32 id) {
+  uint32 task;
+  while (Pop(id, task) || Steal(id, task)) {
+    (*job)(task);
+    if (--remaining == 0) {
+      std::lock_guard<std::mutex> guard(lock);
+      done.notify_all();
+    }
+  }
+}
+
+void TaskPool::WorkerLoop(uint32 id) {
+  uint64 seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      wake.wait(guard, [&] { return stop || generation != seen; });
+      if (stop) return;
+      seen = generation;
+    }
+    Drain(id);
+  }
+}
+
+void TaskPool::ParallelFor(uint32 count, const std::function<void(uint32)>& fn) {
+  if (!count) return;
+  if (queueCount < 2) {
+    for (uint32 i = 0; i < count; i++) fn(i);
+    return;
+  }
+
+  std::lock_guard<std::mutex> running(jobLock);
+  job = &fn;
+  remaining = count;
+  for (uint32 id = 0; id < queueCount; id++) {
+    auto& queue = queues[id];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    for (uint32 i = (uint64)count * id / queueCount; i < (uint64)count * (id + 1) / queueCount; i++) {
+      queue.tasks.push_back(i);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    generation++;
+  }
+  wake.notify_all();
+
+  Drain(queueCount - 1);
+
+  std::unique_lock<std::mutex> guard(lock);
+  done.wait(guard, [&] { return remaining == 0; });
+}
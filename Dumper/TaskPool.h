@@ -0,0 +1,53 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "defs.h"
+
+// Work-stealing thread pool.
+// ParallelFor deals contiguous ranges of task indices to every worker's deque,
+// a worker pops from the front of its own deque and steals from the back of
+// the others once it runs dry. The calling thread takes part as the last worker.
+class TaskPool {
+private:
+  struct Queue {
+    std::mutex lock;
+    std::deque<uint32> tasks;
+  };
+
+  std::vector<std::thread> threads;
+  std::unique_ptr<Queue[]> queues;
+  uint32 queueCount = 1;
+
+  std::mutex jobLock; // one ParallelFor at a time
+  std::mutex lock;
+  std::condition_variable wake;
+  std::condition_variable done;
+  const std::function<void(uint32)>* job = nullptr;
+  uint64 generation = 0;
+  std::atomic<uint32> remaining = 0;
+  bool stop = false;
+
+  TaskPool() : queues(new Queue[1]) {};
+  bool Pop(uint32 id, uint32& task);
+  bool Steal(uint32 id, uint32& task);
+  void Drain(uint32 id);
+  void WorkerLoop(uint32 id);
+
+public:
+  static TaskPool* GetInstance() {
+    static TaskPool pool;
+    return &pool;
+  }
+  ~TaskPool();
+  // Spawns 'count - 1' workers, the caller of ParallelFor is the last one
+  void Start(uint32 count);
+  uint32 GetThreadCount() const { return queueCount; }
+  // Calls fn(i) for every i in [0, count) and returns once all of them finished
+  void ParallelFor(uint32 count, const std::function<void(uint32)>& fn);
+};
@@ -0,0 +1,112 @@
+#include "TypeRef.h"
+
+size_t TypeTable::NodeHash::operator()(const TypeNode& node) const {
+  size_t hash = std::hash<std::string>()(node.Name);
+  auto mix = [&hash](size_t value) { hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2); };
+  mix((size_t)node.Kind << 16 | (size_t)node.Keyword << 8 | node.Pointer);
+  mix((uint32)node.Ref);
+  for (auto arg : node.Args) mix(arg);
+  return hash;
+}
+
+static TypeNode VoidNode() {
+  TypeNode node;
+  node.Name = "void";
+  return node;
+}
+
+std::mutex TypeTable::lock;
+ChunkedArray<TypeNode> TypeTable::nodes = { TypeNode(), VoidNode() };
+std::unordered_set<TypeRef, TypeTable::NodeHash, TypeTable::NodeEqual> TypeTable::nodeSet = { 0, Void };
+
+TypeRef TypeTable::Intern(TypeNode&& node) {
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = nodeSet.find(node);
+  if (it != nodeSet.end()) return *it;
+  TypeRef id = nodes.PushBack(std::move(node));
+  nodeSet.insert(id);
+  return id;
+}
+
+TypeRef TypeTable::Basic(const std::string& name, TypeKeyword keyword, uint8 pointer) {
+  TypeNode node;
+  node.Kind = TypeKind::Basic;
+  node.Keyword = keyword;
+  node.Pointer = pointer;
+  node.Name = name;
+  return Intern(std::move(node));
+}
+
+TypeRef TypeTable::Struct(int32 ref, const std::string& cppName, TypeKeyword keyword, uint8 pointer) {
+  TypeNode node;
+  node.Kind = TypeKind::Struct;
+  node.Keyword = keyword;
+  node.Pointer = pointer;
+  node.Ref = ref;
+  node.Name = cppName;
+  return Intern(std::move(node));
+}
+
+TypeRef TypeTable::Enum(int32 ref, const std::string& name) {
+  TypeNode node;
+  node.Kind = TypeKind::Enum;
+  node.Keyword = TypeKeyword::EnumClass;
+  node.Ref = ref;
+  node.Name = name;
+  return Intern(std::move(node));
+}
+
+TypeRef TypeTable::Template(const std::string& name, std::vector<TypeRef> args) {
+  TypeNode node;
+  node.Kind = TypeKind::Template;
+  node.Keyword = TypeKeyword::Struct;
+  node.Name = name;
+  node.Args = std::move(args);
+  return Intern(std::move(node));
+}
+
+TypeRef TypeTable::Opaque(TypeRef type) {
+  TypeNode node;
+  node.Kind = TypeKind::Opaque;
+  node.Args = { type };
+  return Intern(std::move(node));
+}
+
+TypeRef TypeTable::PointerTo(TypeRef type) {
+  auto node = Get(type);
+  node.Pointer++;
+  return Intern(std::move(node));
+}
+
+std::string TypeTable::Render(TypeRef type) {
+  auto& node = Get(type);
+  if (node.Kind == TypeKind::Opaque) {
+    return "/*" + Render(node.Args[0]) + "*/char";
+  }
+
+  std::string result;
+  switch (node.Keyword) {
+  case TypeKeyword::Struct: result = "struct "; break;
+  case TypeKeyword::Class: result = "class "; break;
+  case TypeKeyword::EnumClass: result = "enum class "; break;
+  }
+  result += node.Name;
+  if (node.Kind == TypeKind::Template) {
+    result += "<";
+    for (size_t i = 0; i < node.Args.size(); i++) {
+      if (i) result += ", ";
+      result += Render(node.Args[i]);
+    }
+    result += ">";
+  }
+  result.append(node.Pointer, '*');
+  return result;
+}
+
+bool TypeTable::HasPointer(TypeRef type) {
+  bool pointer = false;
+  ForEach(type, [&pointer](const TypeNode& node) {
+    if (node.Pointer) pointer = true;
+  });
+  return pointer;
+}
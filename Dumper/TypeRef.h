@@ -0,0 +1,88 @@
+#pragma once
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "defs.h"
+#include "ChunkedArray.h"
+
+// Id of an interned TypeNode, equal types always get the same id.
+// 0 is the empty type of members that have no property behind them.
+typedef uint32 TypeRef;
+
+enum class TypeKind : uint8 {
+  Basic,    // builtin or engine type with a fixed spelling (float, FName, ...)
+  Struct,   // UClass/UScriptStruct, Ref is its object index
+  Enum,     // UEnum, Ref is its object index
+  Template, // Name<Args...>
+  Opaque    // Args[0] could not be resolved, emitted as a commented out type of char
+};
+
+enum class TypeKeyword : uint8 {
+  None,
+  Struct,   // struct X
+  Class,    // class X
+  EnumClass // enum class X
+};
+
+// Structured type of a member or parameter.
+// Generation builds these from the reflection wrappers, the reference solver walks
+// them and text is only rendered when the SDK files are written.
+struct TypeNode {
+  TypeKind Kind = TypeKind::Basic;
+  TypeKeyword Keyword = TypeKeyword::None;
+  uint8 Pointer = 0;  // levels of indirection
+  int32 Ref = -1;     // ObjTable index of the struct/enum
+  std::string Name;   // spelling without keyword, template arguments and pointers
+  std::vector<TypeRef> Args;
+
+  bool operator==(const TypeNode&) const = default;
+};
+
+// Nodes are read by every generating thread and the writer, so reads take no lock,
+// only interning a new node does.
+class TypeTable {
+  // The set holds ids and hashes the nodes behind them, a node is looked up without an id
+  struct NodeHash {
+    using is_transparent = void;
+    size_t operator()(const TypeNode& node) const;
+    size_t operator()(TypeRef type) const { return (*this)(Get(type)); }
+  };
+  struct NodeEqual {
+    using is_transparent = void;
+    bool operator()(TypeRef a, TypeRef b) const { return a == b; }
+    bool operator()(const TypeNode& node, TypeRef type) const { return node == Get(type); }
+    bool operator()(TypeRef type, const TypeNode& node) const { return node == Get(type); }
+  };
+
+  static std::mutex lock; // taken by Intern only
+  static ChunkedArray<TypeNode> nodes;
+  static std::unordered_set<TypeRef, NodeHash, NodeEqual> nodeSet;
+
+  static TypeRef Intern(TypeNode&& node);
+
+  friend class PackageIR;
+
+public:
+  // 'void', interned before any other type
+  static constexpr TypeRef Void = 1;
+
+  static TypeRef Basic(const std::string& name, TypeKeyword keyword = TypeKeyword::None, uint8 pointer = 0);
+  static TypeRef Struct(int32 ref, const std::string& cppName, TypeKeyword keyword = TypeKeyword::Struct, uint8 pointer = 0);
+  static TypeRef Enum(int32 ref, const std::string& name);
+  static TypeRef Template(const std::string& name, std::vector<TypeRef> args);
+  static TypeRef Opaque(TypeRef type);
+  // Same type with one more level of indirection
+  static TypeRef PointerTo(TypeRef type);
+
+  static const TypeNode& Get(TypeRef type) { return nodes[type]; }
+  static std::string Render(TypeRef type);
+  // True if the type or any of its template arguments is a pointer
+  static bool HasPointer(TypeRef type);
+  // Calls fn for the node and every template argument below it
+  template <typename Fn> static void ForEach(TypeRef type, Fn&& fn) {
+    auto& node = Get(type);
+    fn(node);
+    for (auto arg : node.Args) ForEach(arg, fn);
+  }
+};
@@ -18,7 +18,8 @@ enum class STATUS {
   CANNOT_READ,
   INVALID_IMAGE,
   FILE_NOT_OPEN,
-  ZERO_PACKAGES
+  ZERO_PACKAGES,
+  ROOTS_NOT_FOUND
 };
 
 #define GNameSpace "Dumper"
\ No newline at end of file
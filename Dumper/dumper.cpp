@@ -1,5 +1,6 @@
 #include <Windows.h>
 #include <fmt/core.h>
+#include <fmt/format.h>
 #include "dumper.h"
 #include "engine.h"
 #include "memory.h"
@@ -8,6 +9,12 @@
 #include "RefGraphSolver.h"
 #include "EngineHeaderExport.h"
 #include "ClassSizeFixer.h"
+#include "ObjectTable.h"
+#include "TaskPool.h"
+#include "BoundedQueue.h"
+#include "FileWriter.h"
+#include "PackageIR.h"
+#include "DumpScope.h"
 
 Dumper::~Dumper() {
   if (Image) VirtualFree(Image, 0, MEM_RELEASE);
@@ -18,7 +25,7 @@ STATUS Dumper::Init(int argc, char *argv[]) {
     auto arg = argv[i];
     uint16 arg16 = *(uint16*)arg;
     if (arg16 == 'h-') {
-      printf("'-p' - dump only names and objects\n'-w' - wait for input (it gives me time to inject mods)\n'-f packageNameHere' - specifies package where we should look for pointers in paddings (can take a lot of time)");
+      printf("'-p' - dump only names and objects\n'-w' - wait for input (it gives me time to inject mods)\n'-f packageNameHere' - specifies package where we should look for pointers in paddings (can take a lot of time)\n'-j threadCount' - number of threads reading the game (default: one per hardware thread)\n'-r ObjectName' - dump only this class/struct/enum and the types it depends on, can be repeated\n'--from-ir path' - write the SDK again from the SDK.ir of an earlier dump, without the game");
       return STATUS::FAILED;
     } else if (arg16 == 'p-') {
       Full = false;
@@ -28,16 +35,39 @@ STATUS Dumper::Init(int argc, char *argv[]) {
       i++;
       if (i < argc) {  PackageName = argv[i]; }
       else { return STATUS::FAILED; }
+    } else if (arg16 == 'j-') {
+      i++;
+      if (i >= argc) { return STATUS::FAILED; }
+      // strtoul wraps negative counts around instead of failing
+      char* end;
+      auto threads = strtoul(argv[i], &end, 10);
+      if (end == argv[i] || *end || argv[i][0] == '-' || threads == 0 || threads > 1024) { return STATUS::FAILED; }
+      Threads = (uint32)threads;
+    } else if (arg16 == 'r-') {
+      i++;
+      if (i < argc) { Roots.push_back(argv[i]); }
+      else { return STATUS::FAILED; }
     }
     else if (!strcmp(arg, "--spacing")) {
       Spacing = true;
     }
+    else if (!strcmp(arg, "--from-ir")) {
+      i++;
+      if (i < argc) { IRFile = argv[i]; }
+      else { return STATUS::FAILED; }
+    }
   }
 
   if (Wait) {
     system("pause");
   }
 
+  if (!IRFile.empty()) {
+    // nothing is read from the game, the SDK is written next to the IR
+    Directory = IRFile.parent_path();
+    return STATUS::SUCCESS;
+  }
+
   uint32_t pid = 0;
 
   {
@@ -83,8 +113,8 @@ STATUS Dumper::Init(int argc, char *argv[]) {
     return EngineInit(game.string(), Image);
   }
 }
-void Dumper::GenerateSDKHeader(const fs::path& dir) {
-  File file(dir / "SDK.h", "w");
+void Dumper::GenerateSDKHeader(const fs::path& dir, FileWriter& writer) {
+  fmt::memory_buffer file;
   const std::vector<std::string> stlLib = {
     "set",
     "string",
@@ -101,18 +131,18 @@ void Dumper::GenerateSDKHeader(const fs::path& dir) {
     4099,
   };
   for (auto& stlName : stlLib) {
-    fmt::print(file, "#include <{}>\n", stlName);
+    fmt::format_to(std::back_inserter(file), "#include <{}>\n", stlName);
   }
 
   for (auto& code : ignoreWarningCode) {
-    fmt::print(file, "#pragma warning(disable: {})\n", code);
+    fmt::format_to(std::back_inserter(file), "#pragma warning(disable: {})\n", code);
   }
 
-  fmt::print(file, "\n// Note: The content of GlobalOffset.h should be updated by yourself!! \n\n");
+  fmt::format_to(std::back_inserter(file), "\n// Note: The content of GlobalOffset.h should be updated by yourself!! \n\n");
 
-  fmt::print(file, "#include \"GlobalOffset.h\"\n");
+  fmt::format_to(std::back_inserter(file), "#include \"GlobalOffset.h\"\n");
 
-  fmt::print(file, "\n// SDK headers \n\n");
+  fmt::format_to(std::back_inserter(file), "\n// SDK headers \n\n");
   for (auto& packageName : RefGraphSolver::packageHeaderOrder) {
     if (packageName == "CppTypes") continue; // ignore
 
@@ -123,12 +153,114 @@ void Dumper::GenerateSDKHeader(const fs::path& dir) {
         packageName[pos] = '_';
       }
     }
-    fmt::print(file, "#include \"SDK/{}_package.h\"\n", packageName);
+    fmt::format_to(std::back_inserter(file), "#include \"SDK/{}_package.h\"\n", packageName);
+  }
+  writer.Write(dir / "SDK.h", std::move(file));
+
+}
+
+// Solves and saves the packages 'generate' hands over on a thread of its own, then
+// writes SDK.h. Packages are written to the IR before they are solved.
+void Dumper::SaveSDK(const std::function<void(const std::function<void(UE_UPackage&)>&)>& generate, FileWriter& files, PackageIR* ir) {
+  // ٵsdk
+  // Generated packages are solved and written on their own thread while the next
+  // ones are generated, the queue bounds how far generation runs ahead of it
+  // and the finished files go to the disk on a third one
+  auto path = Directory / "SDK";
+  int saved = 0;
+  std::string unsaved{};
+  std::string changed{};
+  std::vector<UE_UPackage*> savedPackages;
+  std::vector<bool> packageChanged;
+  BoundedQueue<UE_UPackage*> generated(16);
+  std::thread writer([&] {
+    std::unordered_map<std::string, int> paramStructNameMp;
+    UE_UPackage* package;
+    while (generated.Pop(package)) {
+      if (ir) ir->Add(*package);
+      RefGraphSolver::SolvePackage(*package);
+      UE_UPackage::ResolveParamStructNames(*package, paramStructNameMp);
+      auto written = files.Changed();
+      if (package->Save(path, Spacing, files)) {
+        saved++;
+        savedPackages.push_back(package);
+        packageChanged.push_back(files.Changed() != written);
+      } else {
+        unsaved += (package->packageName + ", ");
+      };
+      package->Release();
+    }
+  });
+  generate([&](UE_UPackage& package) { generated.Push(&package); });
+  generated.Close();
+  writer.join();
+  printf("\n");
+
+  if (ir && !ir->Finish()) {
+    printf("[ERROR] Can't save SDK.ir\n");
+  }
+
+  // only the header order and the includes of the package headers need every package
+  RefGraphSolver::SortPackages();
+  for (size_t i = 0; i < savedPackages.size(); i++) {
+    std::vector<std::string> includes, declares;
+    RefGraphSolver::GetPackageRefs(savedPackages[i]->packageName, includes, declares);
+    if (savedPackages[i]->SavePackageHeader(path, includes, declares, files)) {
+      packageChanged[i] = true;
+    }
+    if (packageChanged[i]) {
+      changed += (savedPackages[i]->packageName + ", ");
+    }
+  }
+
+  // ܵSDKͷļ
+  Dumper::GenerateSDKHeader(Directory, files);
+  auto unwritten = files.Finish();
+
+  fmt::print("\nSaved packages: {}\n", saved);
+
+  if (unsaved.size()) {
+    unsaved.erase(unsaved.size() - 2);
+    fmt::print("Unsaved empty packages: [ {} ]\n", unsaved);
+  }
+  if (changed.size()) {
+    changed.erase(changed.size() - 2);
+    fmt::print("Changed packages: [ {} ]\n", changed);
+  } else {
+    fmt::print("Changed packages: none\n");
+  }
+  if (unwritten.size()) {
+    unwritten.erase(unwritten.size() - 2);
+    fmt::print("Unwritten files: [ {} ]\n", unwritten);
   }
+}
+
+STATUS Dumper::DumpFromIR() {
+  std::vector<UE_UPackage> packages;
+  if (!PackageIR::Load(IRFile, packages, gameName)) {
+    return STATUS::FILE_NOT_OPEN;
+  }
+  fmt::print("Packages: {}\n", packages.size());
+  fs::create_directories(Directory / "SDK");
 
+  FileWriter files(Directory);
+  EngineHeaderExport::Process(Directory, files);
+  RefGraphSolver::LoadPackages(packages);
+
+  fmt::print("Writing sdk files... \n");
+  SaveSDK([&](auto& onPackage) {
+    for (auto& package : packages) onPackage(package);
+  }, files, nullptr);
+  return STATUS::SUCCESS;
 }
 
 STATUS Dumper::Dump() {
+  if (!IRFile.empty()) {
+    return DumpFromIR();
+  }
+
+  TaskPool::GetInstance()->Start(Threads ? Threads : std::thread::hardware_concurrency());
+
   /*
    * Names dumping.
    * We go through each block, except last, that is not fully filled.
@@ -153,33 +285,65 @@ STATUS Dumper::Dump() {
       if (!file) { return STATUS::FILE_NOT_OPEN; }
       size_t size = 0;
 
+      // Every field needed below is read once here, the loop only touches local data
+      ObjTable.Build();
 
-      std::function<void(UE_UObject)> callback;
-      if (Full) {
-        callback = [&file, &size, &packages](UE_UObject object) {
+      // Limiting packages to the types needed by the roots
+      bool scoped = Full && Roots.size();
+      if (scoped) {
+        auto count = DumpScope::Build(Roots);
+        if (!count) {
+          return STATUS::ROOTS_NOT_FOUND;
+        }
+        fmt::print("Scope: {} types, {} declared only\n", count, DumpScope::DeclaredCount());
+      }
 
-          auto isFunction = object.IsA<UE_UFunction>();
+      auto functionClass = ObjTable.IndexOf(UE_UFunction::StaticClass());
+      auto structClass = ObjTable.IndexOf(UE_UStruct::StaticClass());
+      auto enumClass = ObjTable.IndexOf(UE_UEnum::StaticClass());
+
+      // Name decoding still reads the game, so blocks of objects are formatted in parallel.
+      // Each block keeps its own lines and package buckets, they are merged in index order.
+      struct Block {
+        fmt::memory_buffer lines;
+        std::vector<std::pair<uint8*, UE_UObject>> objects; // package, object
+        size_t size = 0;
+      };
+      auto blockSize = ObjectTable::BlockSize;
+      std::vector<Block> blocks((ObjTable.Num() + blockSize - 1) / blockSize);
+
+      TaskPool::GetInstance()->ParallelFor((uint32)blocks.size(), [&](uint32 id) {
+        auto& block = blocks[id];
+        auto out = std::back_inserter(block.lines);
+        auto end = (std::min)(ObjTable.Num(), (id + 1) * blockSize);
+        for (uint32 i = id * blockSize; i < end; i++) {
+          UE_UObject object = ObjTable.Address[i];
+          if (!object) continue;
+
+          auto isFunction = Full && ObjTable.IsA(i, functionClass);
           if (isFunction) {
-            fmt::print(file, "[{:0>6}] <{}> <{}> {} {:x}\n", object.GetIndex(), object.GetAddress(), Read<void*>(object.GetAddress()), object.GetFullName(), object.Cast<UE_UFunction>().GetFunc() - Base);
+            fmt::format_to(out, "[{:0>6}] <{}> <{}> {} {:x}\n", i, object.GetAddress(), (void*)ObjTable.VTable[i], ObjTable.GetFullName(i), object.Cast<UE_UFunction>().GetFunc() - Base);
           }
           else {
-            fmt::print(file, "[{:0>6}] <{}> <{}> {}\n", object.GetIndex(), object.GetAddress(), Read<void*>(object.GetAddress()), object.GetFullName());
+            fmt::format_to(out, "[{:0>6}] <{}> <{}> {}\n", i, object.GetAddress(), (void*)ObjTable.VTable[i], ObjTable.GetFullName(i));
           }
-          size++;
-          if (isFunction || object.IsA<UE_UStruct>() || object.IsA<UE_UEnum>()) {
-            auto packageObj = object.GetPackageObject();
-            packages[packageObj].push_back(object);
+          block.size++;
+          if (!Full) continue;
+          if (scoped && !DumpScope::Contains(i) && !DumpScope::IsDeclared(i)) continue;
+          if (isFunction || ObjTable.IsA(i, structClass) || ObjTable.IsA(i, enumClass)) {
+            auto package = ObjTable.Package[i];
+            block.objects.push_back({ package != -1 ? ObjTable.Address[package] : nullptr, object });
           }
-        };
-      }
-      else {
-        callback = [&file, &size](UE_UObject object){
-          fmt::print(file, "[{:0>6}] <{}> <{}> {}\n", object.GetIndex(), object.GetAddress(), Read<void*>(object.GetAddress()), object.GetFullName());
-          size++;
-        };
-      }
+        }
+      });
 
-      ObjObjects.Dump(callback);
+      for (auto& block : blocks) {
+        fwrite(block.lines.data(), 1, block.lines.size(), file);
+        size += block.size;
+        for (auto& [package, object] : block.objects) {
+          packages[package].push_back(object);
+        }
+      }
 
       fmt::print("Objects: {}\n", size);
     }
@@ -206,63 +370,41 @@ STATUS Dumper::Dump() {
     fmt::print("Packages: {}\n", packages.size());
     std::vector<UE_UPackage> processedPackage;
     {
-      auto path = Directory / "SDK";
-      fs::create_directories(path);
+      fs::create_directories(Directory / "SDK");
 
       // Դͷ
-      EngineHeaderExport::Process(Directory);
-
-      int i = 1;
-      int saved = 0;
-      std::string unsaved{};
+      // Unchanged files of the last dump are skipped, see FileWriter
+      FileWriter files(Directory);
+      EngineHeaderExport::Process(Directory, files);
 
       bool lock = true;
       if (PackageName) lock = false;
 
       // ޸С
       for (UE_UPackage package : packages) {
-        fmt::print("\rFixing class size: {}/{}", i++, packages.size());
-        ClassSizeFixer::LoadPackage(package);
         processedPackage.push_back(package);
       }
-      printf("\n");
       int fixedClassCnt = ClassSizeFixer::FixAllPackage(processedPackage);
       printf("fixed %d classes size!\n", fixedClassCnt);
-      i = 1;
       // ȫ
       for (UE_UPackage& package : processedPackage) {
-        fmt::print("\rProcessing: {}/{}", i++, packages.size());
-
         if (!lock && package.GetObject().GetName() == PackageName) {
           package.FindPointers = true;
           lock = true;
         }
-        package.Process();
       }
-
+      UE_UPackage::DeclareTypes(processedPackage);
       // ٽϵ
-      RefGraphSolver::Process(processedPackage);
+      RefGraphSolver::NamePackages(processedPackage);
+      RefGraphSolver::LoadPackages(processedPackage);
 
       fmt::print("Writing sdk files... \n");
 
-      // ٵsdk
-      for (UE_UPackage& package : processedPackage) {
-        if (package.Save(path, Spacing)) {
-          saved++;
-        } else {
-          unsaved += (package.GetObject().GetName() + ", ");
-        };
-      }
-
-      // ܵSDKͷļ
-      Dumper::GenerateSDKHeader(Directory);
-
-      fmt::print("\nSaved packages: {}\n", saved);
-
-      if (unsaved.size()) {
-        unsaved.erase(unsaved.size() - 2);
-        fmt::print("Unsaved empty packages: [ {} ]\n", unsaved);
+      PackageIR ir(Directory / "SDK.ir", gameName);
+      if (!ir) {
+        printf("[ERROR] Can't create SDK.ir\n");
       }
+      SaveSDK([&](auto& onPackage) { UE_UPackage::Process(processedPackage, onPackage); }, files, ir ? &ir : nullptr);
 
       
 
@@ -1,6 +1,13 @@
 #pragma once
 #include "defs.h"
 #include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+class FileWriter;
+class PackageIR;
+class UE_UPackage;
 
 namespace fs = std::filesystem;
 
@@ -9,13 +16,18 @@ protected:
   bool Full = true;
   bool Wait = false;
   bool Spacing = false;
+  uint32 Threads = 0; // 0 - one per hardware thread
+  std::vector<std::string> Roots; // empty - dump every package
   fs::path Directory;
+  fs::path IRFile; // write the SDK from this IR instead of the game
   const char* PackageName = nullptr;
   void* Image = nullptr;
  
 
 private:
   Dumper(){};
+  void SaveSDK(const std::function<void(const std::function<void(UE_UPackage&)>&)>& generate, FileWriter& files, PackageIR* ir);
+  STATUS DumpFromIR();
 
 public:
   std::string gameName;
@@ -25,6 +37,6 @@ public:
   }
   ~Dumper();
   STATUS Init(int argc, char *argv[]);
-  void GenerateSDKHeader(const fs::path& dir);
+  void GenerateSDKHeader(const fs::path& dir, FileWriter& writer);
   STATUS Dump();
 };
@@ -1,471 +1,65 @@
 #include <Windows.h>
 #include "engine.h"
+#include "profiles.h"
 #include "generic.h"
 #include "memory.h"
 #include "utils.h"
 #include "wrappers.h"
+#include "ReflectionClasses.h"
 
 Offsets offsets;
+OffsetsProfile profile = OffsetsProfile::Runtime;
 
 ansi_fn Decrypt_ANSI = nullptr;
 // wide_fn Decrypt_WIDE = nullptr;
 
-struct {
-  uint16 Stride = 2;
-  struct {
-    uint16 Size = 24;
-  } FUObjectItem;
-  struct {
-    uint16 Number = 4;
-  } FName;
-  struct {
-    uint16 Info = 0;
-    uint16 WideBit = 0;
-    uint16 LenBit = 6;
-    uint16 HeaderSize = 2;
-  } FNameEntry;
-  struct {
-    uint16 Index = 0xC;
-    uint16 Class = 0x10;
-    uint16 Name = 0x18;
-    uint16 Outer = 0x20;
-  } UObject;
-  struct {
-    uint16 Next = 0x28;
-  } UField;
-  struct {
-    uint16 SuperStruct = 0x40;
-    uint16 Children = 0x48;
-    uint16 ChildProperties = 0x50;
-    uint16 PropertiesSize = 0x58;
-  } UStruct;
-  struct {
-    uint16 Names = 0x40;
-  } UEnum;
-  struct {
-    uint16 FunctionFlags = 0xB0;
-    uint16 Func = 0xB0 + 0x28;
-  } UFunction;
-  struct {
-    uint16 Class = 0x8;
-    uint16 Next = 0x20;
-    uint16 Name = 0x28;
-  } FField;
-  struct {
-    uint16 ArrayDim = 0x38;
-    uint16 ElementSize = 0x3C;
-    uint16 PropertyFlags = 0x40;
-    uint16 Offset = 0x4C;
-    uint16 Size = 0x78;
-  } FProperty;
-  struct {
-    uint16 ArrayDim = 0;
-    uint16 ElementSize = 0;
-    uint16 PropertyFlags = 0;
-    uint16 Offset = 0;
-    uint16 Size = 0; // sizeof(UProperty)
-  } UProperty;
-} Default;
-static_assert(sizeof(Default) == sizeof(Offsets));
-
-struct
-{
-    uint16 Stride = 2;
-    struct
-    {
-        uint16 Size = 24;
-    } FUObjectItem;
-    struct
-    {
-        uint16 Number = 4;
-    } FName;
-    struct
-    {
-        uint16 Info = 0;
-        uint16 WideBit = 0;
-        uint16 LenBit = 6;
-        uint16 HeaderSize = 2;
-    } FNameEntry;
-    struct
-    {
-        uint16 Index = 0xC;
-        uint16 Class = 0x10;
-        uint16 Name = 0x18;
-        uint16 Outer = 0x20;
-    } UObject;
-    struct
-    {
-        uint16 Next = 0x28;
-    } UField;
-    struct
-    {
-        uint16 SuperStruct = 0x40;
-        uint16 Children = 0x48;
-        uint16 ChildProperties = 0;
-        uint16 PropertiesSize = 0x50;
-    } UStruct;
-    struct
-    {
-        uint16 Names = 0x40;
-    } UEnum;
-    struct
-    {
-        uint16 FunctionFlags = 0x98;
-        uint16 Func = 0xC0;
-    } UFunction;
-    struct
-    {
-        uint16 Class = 0;
-        uint16 Next = 0;
-        uint16 Name = 0;
-    } FField;
-    struct
-    {
-        uint16 ArrayDim = 0;
-        uint16 ElementSize = 0;
-        uint16 PropertyFlags = 0;
-        uint16 Offset = 0;
-        uint16 Size = 0;
-    } FProperty;
-    struct
-    {
-        uint16 ArrayDim = 0x30;
-        uint16 ElementSize = 0x34;
-        uint16 PropertyFlags = 0x38;
-        uint16 Offset = 0x44;
-        uint16 Size = 0x70; // sizeof(UProperty)
-    } UProperty;
-} Squad;
-static_assert(sizeof(Squad) == sizeof(Offsets));
-
-struct {
-  uint16 Stride = 4;
-  struct {
-    uint16 Size = 24;
-  } FUObjectItem;
-  struct {
-    uint16 Number = 8;
-  } FName;
-  struct {
-    uint16 Info = 4;
-    uint16 WideBit = 0;
-    uint16 LenBit = 1;
-    uint16 HeaderSize = 6;
-  } FNameEntry;
-  struct {
-    uint16 Index = 0xC;
-    uint16 Class = 0x10;
-    uint16 Name = 0x18;
-    uint16 Outer = 0x28;
-  } UObject;
-  struct {
-    uint16 Next = 0x30;
-  } UField;
-  struct {
-    uint16 SuperStruct = 0x48;
-    uint16 Children = 0x50;
-    uint16 ChildProperties = 0x58;
-    uint16 PropertiesSize = 0x60;
-  } UStruct;
-  struct {
-    uint16 Names = 0x48;
-  } UEnum;
-  struct {
-    uint16 FunctionFlags = 0xB8;
-    uint16 Func = 0xB8 + 0x28; // ue3-ue4, always +0x28 from flags location.
-  } UFunction;
-  struct {
-    uint16 Class = 0x8;
-    uint16 Next = 0x20;
-    uint16 Name = 0x28;
-  } FField;
-  struct {
-    uint16 ArrayDim = 0x38;
-    uint16 ElementSize = 0x3C;
-    uint16 PropertyFlags = 0x40;
-    uint16 Offset = 0x4C;
-    uint16 Size = 0x80;
-  } FProperty;
-  struct {
-    uint16 ArrayDim = 0;
-    uint16 ElementSize = 0;
-    uint16 PropertyFlags = 0;
-    uint16 Offset = 0;
-    uint16 Size = 0; // sizeof(UProperty)
-  } UProperty;
-} DeadByDaylight;
-static_assert(sizeof(DeadByDaylight) == sizeof(Offsets));
-
-struct {
-  uint16 Stride = 2;
-  struct {
-    uint16 Size = 24;
-  } FUObjectItem;
-  struct {
-    uint16 Number = 4;
-  } FName;
-  struct {
-    uint16 Info = 0;
-    uint16 WideBit = 0;
-    uint16 LenBit = 6;
-    uint16 HeaderSize = 2;
-  } FNameEntry;
-  struct {
-    uint16 Index = 0xC;
-    uint16 Class = 0x10;
-    uint16 Name = 0x18;
-    uint16 Outer = 0x20;
-  } UObject;
-  struct {
-    uint16 Next = 0x28;
-  } UField;
-  struct {
-    uint16 SuperStruct = 0x40;
-    uint16 Children = 0x48;
-    uint16 ChildProperties = 0x50;
-    uint16 PropertiesSize = 0x58;
-  } UStruct;
-  struct {
-    uint16 Names = 0x40;
-  } UEnum;
-  struct {
-    uint16 FunctionFlags = 0xB0;
-    uint16 Func = 0xB0 + 0x30;
-  } UFunction;
-  struct {
-    uint16 Class = 0x8;
-    uint16 Next = 0x20;
-    uint16 Name = 0x28;
-  } FField;
-  struct {
-    uint16 ArrayDim = 0x38;
-    uint16 ElementSize = 0x3C;
-    uint16 PropertyFlags = 0x40;
-    uint16 Offset = 0x4C;
-    uint16 Size = 0x78;
-  } FProperty;
-  struct {
-    uint16 ArrayDim = 0;
-    uint16 ElementSize = 0;
-    uint16 PropertyFlags = 0;
-    uint16 Offset = 0;
-    uint16 Size = 0; // sizeof(UProperty)
-  } UProperty;
-} Scavengers;
-static_assert(sizeof(Scavengers) == sizeof(Offsets));
-
-struct {
-  uint16 Stride = 2;
-  struct {
-    uint16 Size = 32;
-  } FUObjectItem;
-  struct {
-    uint16 Number = 4;
-  } FName;
-  struct {
-    uint16 Info = 0;
-    uint16 WideBit = 0;
-    uint16 LenBit = 6;
-    uint16 HeaderSize = 2;
-  } FNameEntry;
-  struct {
-    uint16 Index = 0xC;
-    uint16 Class = 0x10;
-    uint16 Name = 0x18;
-    uint16 Outer = 0x20;
-  } UObject;
-  struct {
-    uint16 Next = 0x28;
-  } UField;
-  struct {
-    uint16 SuperStruct = 0x40;
-    uint16 Children = 0x48;
-    uint16 ChildProperties = 0x50;
-    uint16 PropertiesSize = 0x58;
-  } UStruct;
-  struct {
-    uint16 Names = 0x40;
-  } UEnum;
-  struct {
-    uint16 FunctionFlags = 0xB0;
-    uint16 Func = 0xB0 + 0x28;
-  } UFunction;
-  struct {
-    uint16 Class = 0x8;
-    uint16 Next = 0x20;
-    uint16 Name = 0x28;
-  } FField;
-  struct {
-    uint16 ArrayDim = 0x38;
-    uint16 ElementSize = 0x3C;
-    uint16 PropertyFlags = 0x40;
-    uint16 Offset = 0x4C;
-    uint16 Size = 0x78;
-  } FProperty;
-  struct {
-    uint16 ArrayDim = 0;
-    uint16 ElementSize = 0;
-    uint16 PropertyFlags = 0;
-    uint16 Offset = 0;
-    uint16 Size = 0; // sizeof(UProperty)
-  } UProperty;
-} Brickadia;
-static_assert(sizeof(Brickadia) == sizeof(Offsets));
-
-struct {
-  uint16 Stride = 4;
-  struct {
-    uint16 Size = 24;
-  } FUObjectItem;
-  struct {
-    uint16 Number = 8;
-  } FName;
-  struct {
-    uint16 Info = 4;
-    uint16 WideBit = 0;
-    uint16 LenBit = 1;
-    uint16 HeaderSize = 6;
-  } FNameEntry;
-  struct {
-    uint16 Index = 0xC;
-    uint16 Class = 0x10;
-    uint16 Name = 0x18;
-    uint16 Outer = 0x28;
-  } UObject;
-  struct {
-      uint16 Next = 0x30;
-  } UField;
-  struct {
-    uint16 SuperStruct = 0x48;
-    uint16 Children = 0x50;
-    uint16 ChildProperties = 0x58;
-    uint16 PropertiesSize = 0x60;
-  } UStruct;
-  struct {
-    uint16 Names = 0x48;
-  } UEnum;
-  struct {
-    uint16 FunctionFlags = 0xB8;
-    uint16 Func = 0xB8 + 0x28;
-  } UFunction;
-  struct {
-    uint16 Class = 0x8;
-    uint16 Next = 0x20;
-    uint16 Name = 0x28;
-  } FField;
-  struct {
-    uint16 ArrayDim = 0x38;
-    uint16 ElementSize = 0x3C;
-    uint16 PropertyFlags = 0x40;
-    uint16 Offset = 0x4C;
-    uint16 Size = 0x80;
-  } FProperty;
-  struct {
-    uint16 ArrayDim = 0;
-    uint16 ElementSize = 0;
-    uint16 PropertyFlags = 0;
-    uint16 Offset = 0;
-    uint16 Size = 0; // sizeof(UProperty)
-  } UProperty;
-} Core;
-static_assert(sizeof(Core) == sizeof(Offsets));
-
-struct {
-  uint16 Stride = 2;
-  struct {
-    uint16 Size = 24;
-  } FUObjectItem;
-  struct {
-    uint16 Number = 4;
-  } FName;
-  struct {
-    uint16 Info = 0;
-    uint16 WideBit = 0;
-    uint16 LenBit = 6;
-    uint16 HeaderSize = 2;
-  } FNameEntry;
-  struct {
-    uint16 Index = 0xC;
-    uint16 Class = 0x10;
-    uint16 Name = 0x18;
-    uint16 Outer = 0x20;
-  } UObject;
-  struct {
-    uint16 Next = 0x28;
-  } UField;
-  struct {
-    uint16 SuperStruct = 0x40;
-    uint16 Children = 0x48;
-    uint16 ChildProperties = 0x50;
-    uint16 PropertiesSize = 0x58;
-  } UStruct;
-  struct {
-    uint16 Names = 0x40;
-  } UEnum;
-  struct {
-    uint16 FunctionFlags = 0xB0;
-    uint16 Func = 0xB0 + 0x28;
-  } UFunction;
-  struct {
-    uint16 Class = 0x8;
-    uint16 Next = 0x20;
-    uint16 Name = 0x28;
-  } FField;
-  struct {
-    uint16 ArrayDim = 0x38;
-    uint16 ElementSize = 0x3C;
-    uint16 PropertyFlags = 0x40;
-    uint16 Offset = 0x4C;
-    uint16 Size = 0x78;
-  } FProperty;
-  struct {
-    uint16 ArrayDim = 0x38;
-    uint16 ElementSize = 0x3C;
-    uint16 PropertyFlags = 0x40;
-    uint16 Offset = 0x4C;
-    uint16 Size = 0x78; // sizeof(UProperty)
-  } UProperty;
-} Calabiyau;
-static_assert(sizeof(Calabiyau) == sizeof(Offsets));
+void SelectProfile(OffsetsProfile selected) {
+  profile = selected;
+  WithProfile([]<const auto& P>() {
+    if constexpr (!std::is_same_v<std::remove_cvref_t<decltype(P)>, Offsets>) {
+      offsets = *(const Offsets*)&P;
+    }
+  });
+}
 
 struct {
-  void* offsets; // address to filled offsets structure
+  OffsetsProfile profile;
   std::pair<const char*, uint32> names; // NamePoolData signature
   std::pair<const char*, uint32> objects; // ObjObjects signature
   std::function<bool(void*, void*)> callback;
 } engines[] = {
   { // RogueCompany | PropWitchHuntModule-Win64-Shipping | Scum
-    &Default,
+    OffsetsProfile::Default,
     {"\x48\x8D\x0D\x00\x00\x00\x00\xE8\x00\x00\x00\x00\xC6\x05\x00\x00\x00\x00\x01\x0F\x10\x03\x4C\x8D\x44\x24\x20\x48\x8B\xC8", 30},
     {"\x48\x8B\x05\x00\x00\x00\x00\x48\x8B\x0C\xC8\x48\x8D\x04\xD1\xEB", 16},
     nullptr
   },
   { // Scavenger-Win64-Shipping
-    &Scavengers,
+    OffsetsProfile::Scavengers,
     {"\x48\x8D\x0D\x00\x00\x00\x00\xE8\x00\x00\x00\x00\xC6\x05\x00\x00\x00\x00\x01\x0F\x10\x03\x4C\x8D\x44\x24\x20\x48\x8B\xC8", 30},
     {"\x48\x8B\x05\x00\x00\x00\x00\x48\x8B\x0C\xC8\x48\x8D\x04\xD1\xEB", 16},
     nullptr
   },
   { // DeadByDaylight-Win64-Shipping
-    &DeadByDaylight,
+    OffsetsProfile::DeadByDaylight,
     {"\x48\x8D\x35\x00\x00\x00\x00\xEB\x16", 9},
     {"\x48\x8B\x05\x00\x00\x00\x00\x48\x8B\x0C\xC8\x48\x8D\x04\xD1\xEB", 16},
     nullptr
   },
   { // Brickadia-Win64-Shipping
-    &Brickadia,
+    OffsetsProfile::Brickadia,
     {"\x48\x8D\x0D\x00\x00\x00\x00\xE8\x00\x00\x00\x00\xC6\x05\x00\x00\x00\x00\x00\x85", 20},
     {"\x48\x8B\x05\x00\x00\x00\x00\x48\x63\x8C\x24\xE0", 12},
     nullptr
   },
   { // POLYGON-Win64-Shipping
-    &Default,
+    OffsetsProfile::Default,
     {"\x48\x8D\x35\x00\x00\x00\x00\xEB\x16", 9},
     {"\x48\x8d\x1d\x00\x00\x00\x00\x39\x44\x24\x68", 11},
     nullptr
   },
   { // FortniteClient-Win64-Shipping
-    &Default,
+    OffsetsProfile::Default,
     {"\x4C\x8D\x35\x00\x00\x00\x00\x0F\x10\x07\x83\xFB\x01", 13},
     {"\x48\x8B\x05\x00\x00\x00\x00\x48\x8B\x0C\xC8\x48\x8D\x04\xD1\xEB", 16},
     [](void* start, void* end) {
@@ -494,55 +88,55 @@ struct {
     }
   },
   { // TheIsleClient-Win64-Shipping
-    &Default,
+    OffsetsProfile::Default,
     {"\x48\x8D\x05\x00\x00\x00\x00\xEB\x13", 9},
     {"\x48\x8B\x05\x00\x00\x00\x00\x48\x8B\x0C\xC8\x48\x8D\x04\xD1\xEB\x03", 17},
     nullptr
   },
   { // PortalWars-Win64-Shipping
-    &Default,
+    OffsetsProfile::Default,
     {"\x48\x8D\x0D\x00\x00\x00\x00\xE8\x00\x00\x00\x00\xC6\x05\x00\x00\x00\x00\x01\x0F\x10\x03\x4C\x8D\x44\x24\x20\x48\x8B\xC8", 30},
     {"\x48\x8B\x05\x00\x00\x00\x00\x48\x8B\x0C\xC8\x48\x8D\x1C\xD1\xEB\x03\x49\x8B\xDD", 20},
     nullptr
   },
   { // Tiger-Win64-Shipping.exe
-    &Default,
+    OffsetsProfile::Default,
     {"\x48\x8D\x35\x00\x00\x00\x00\xEB\x16", 9},
     {"\x48\x8d\x1d\x00\x00\x00\x00\x39\x44\x24\x68", 11},
     nullptr
   },
   { // Platform-Win64-Shipping.exe
-    &Core,
+    OffsetsProfile::Core,
     {"\x48\x8D\x35\x00\x00\x00\x00\xEB\x16", 9},
     {"\x48\x8d\x1d\x00\x00\x00\x00\x39\x44\x24\x68", 11},
     nullptr
   },
   {//Beached-Win64-Test.exe
-   &Default,
+   OffsetsProfile::Default,
    {"\x48\x8D\x0D\x00\x00\x00\x00\xE8\xC6\x05\x00\x00\x00\x00\x0F\x10\x03\x4C\x8D\x44\x24\x20\x48\x8B\xC8",30},
    {"\x48\x8B\x05\x00\x00\x00\x00\xC1\xF9\x10\x48\x63\xC9\x48\x8B\x14\xC8\x4B\x8D\x0C\x40\x4C\x8D\x04\xCA\xEB\x03",27},
    nullptr
   },
   {//PromodClient-Win64-Shipping.exe
-   &Default,
+   OffsetsProfile::Default,
    {"\x48\x8D\x0D\x00\x00\x00\x00\xE8\x00\x00\x00\x00\xC6\x05\x00\x00\x00\x00\x01\x0F\x10\x03\x4C\x8D\x44\x24\x20\x48\x8B\xC8",30},
    {"\x48\x8B\x15\x00\x00\x00\x00\x0F\x1F\x44\x00\x00",12},
    nullptr
   }, 
   {//Dauntless-Win64-Shipping.exe
-   &Default,
+   OffsetsProfile::Default,
 	{"\x48\x8d\x0d\x00\x00\x00\x00\xe8\x00\x00\x00\x00\xc6\x05\x00\x00\x00\x00\x00\x0f\x10\x03", 22}, //GName
 	{"\x48\x8B\x05\x00\x00\x00\x00\xC1\xF9", 9},//Gobject 
 	nullptr
   },
   {//SquadGame.exe
-   &Squad,
+   OffsetsProfile::Squad,
     {"\x4C\x8D\x05\x00\x00\x00\x00\xEB\x16\x48\x8D\x0D\x00\x00\x00\x00\xE8\x00\x00\x00\x00", 22}, //GName
     {"\x48\x8D\x1D\x00\x00\x00\x00\x8B\x05\x00\x00\x00\x00\x39\x45\x88\x7C\x20\x48\x8D\x45\x88\x48\x89\x85\x90\x05\x00\x00", 30}, //Gobject 
     nullptr
   },
   { // Calabiyau | Seria
-    &Calabiyau,
+    OffsetsProfile::Calabiyau,
     {"\x48\x8D\x0D\x00\x00\x00\x00\xE8\x00\x00\x00\x00\xC6\x05\x00\x00\x00\x00\x01\x0F\x10\x03\x4C\x8D\x44\x24\x20\x48\x8B\xC8", 30},
     {"\x48\x8B\x05\x00\x00\x00\x00\x48\x8B\x0C\xC8\x48\x8D\x04\xD1\xEB", 16},
     nullptr
@@ -580,7 +174,7 @@ STATUS EngineInit(std::string game, void* image) {
   if (it == games.end()) { return STATUS::ENGINE_NOT_FOUND; }
 
   auto engine = it->second;
-  offsets = *(Offsets*)(engine->offsets);
+  SelectProfile(engine->profile);
 
   void* names = nullptr; 
   void* objects = nullptr;
@@ -616,5 +210,7 @@ STATUS EngineInit(std::string game, void* image) {
     return STATUS::ENGINE_FAILED;
   }
 
+  ReflectionClasses::Resolve();
+
   return STATUS::SUCCESS;
 }
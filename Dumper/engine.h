@@ -7,6 +7,7 @@ struct Offsets {
   uint16 Stride = 0; // alignof(FNameEntry)
   struct {
     uint16 Size = 0;
+    uint16 Flags = 0; // (EInternalObjectFlags Flags)
   } FUObjectItem;
   struct {
     uint16 Number = 0;
@@ -25,6 +26,7 @@ struct Offsets {
     uint16 Class = 0; // Offset to UClass pointer (UClass* ClassPrivate)
     uint16 Name = 0;  // Offset to FName structure
     uint16 Outer = 0; // (UObject* OuterPrivate)
+    uint16 Flags = 0; // (EObjectFlags ObjectFlags)
   } UObject;
   struct {
     uint16 Next = 0;
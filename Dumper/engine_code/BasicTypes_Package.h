@@ -5,6 +5,13 @@
  * Version: VAR_GAME_VERSION
  */
 
+// Included by every package header, so a package header can be used without SDK.h
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <Windows.h>
+#include "../GlobalOffset.h"
+
 #define UE4
 #define FNAME_POOL
 #define GOBJECTS_CHUNKS
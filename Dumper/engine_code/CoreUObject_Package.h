@@ -4,6 +4,9 @@
  * Name: VAR_GAME_NAME
  * Version: VAR_GAME_VERSION
  */
+
+#include "BasicTypes_Package.h"
+
 #ifdef _MSC_VER
 	#pragma pack(push, 0x01)
 #endif
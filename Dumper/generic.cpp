@@ -34,15 +34,20 @@ void FNamePool::Dump(std::function<void(std::string_view, uint32)> callback) con
   DumpBlock(CurrentBlock, CurrentByteCursor, callback);
 }
 
-uint8* TUObjectArray::GetObjectPtr(uint32 id) const {
+uint8* TUObjectArray::GetItemPtr(uint32 id) const {
   if (id >= NumElements) return nullptr;
   uint64 chunkIndex = id / 65536;
   if (chunkIndex >= NumChunks) return nullptr;
   uint8 *chunk = Read<uint8*>(Objects + chunkIndex);
   if (!chunk) return nullptr;
   uint32 withinChunkIndex = id % 65536 * offsets.FUObjectItem.Size;
-  auto item = Read<uint8*>(chunk + withinChunkIndex);
-  return item;
+  return chunk + withinChunkIndex;
+}
+
+uint8* TUObjectArray::GetObjectPtr(uint32 id) const {
+  uint8* item = GetItemPtr(id);
+  if (!item) return nullptr;
+  return Read<uint8*>(item);
 }
 
 void TUObjectArray::Dump(std::function<void(uint8 *)> callback) const {
@@ -63,10 +68,15 @@ UE_UObject TUObjectArray::FindObject(const std::string &name) const {
   return nullptr;
 }
 
-void TUObjectArray::ForEachObjectOfClass(const UE_UClass cmp, std::function<bool(uint8*)> callback) const {
+void TUObjectArray::ForEachObjectOfClass(const UE_UClass cmp, std::function<bool(uint8*)> callback, uint32 skipInternalFlags) const {
   for (uint32 i = 0; i < NumElements; i++) {
-    UE_UObject object = GetObjectPtr(i);
-    if (object && object.IsA(cmp) && object.GetName().find("_Default") == std::string::npos) {
+    uint8* item = GetItemPtr(i);
+    if (!item) continue;
+    UE_UObject object = Read<uint8*>(item);
+    if (!object) continue;
+    if (skipInternalFlags && Read<uint32>(item + offsets.FUObjectItem.Flags) & skipInternalFlags) continue;
+    if (Read<uint32>((uint8*)object + offsets.UObject.Flags) & (RF_ClassDefaultObject | RF_ArchetypeObject)) continue;
+    if (object.IsA(cmp)) {
       if (callback(object)) return;
     }
   }
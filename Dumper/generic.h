@@ -4,6 +4,18 @@
 #include <string>
 #include <string_view>
 
+// Subset of EObjectFlags (UObject::ObjectFlags)
+enum EObjectFlags : uint32 {
+  RF_ClassDefaultObject = 0x00000010,
+  RF_ArchetypeObject = 0x00000020,
+};
+
+// Subset of EInternalObjectFlags (FUObjectItem::Flags)
+enum EInternalObjectFlags : uint32 {
+  EIF_Unreachable = 1 << 28,
+  EIF_PendingKill = 1 << 29,
+};
+
 struct TArray {
   uint8* Data;
   uint32 Count;
@@ -36,10 +48,12 @@ struct TUObjectArray {
   uint32 MaxChunks;
   uint32 NumChunks;
 
+  uint8* GetItemPtr(uint32 id) const;
   uint8* GetObjectPtr(uint32 id) const;
   void Dump(std::function<void(uint8*)> callback) const;
   class UE_UObject FindObject(const std::string &name) const;
-  void ForEachObjectOfClass(const class UE_UClass cmp, std::function<bool(uint8*)> callback) const;
+  // Skips class default objects, archetypes and items with any of 'skipInternalFlags' set
+  void ForEachObjectOfClass(const class UE_UClass cmp, std::function<bool(uint8*)> callback, uint32 skipInternalFlags = 0) const;
   bool IsObject(UE_UObject address) const;
 };
 
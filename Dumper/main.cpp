@@ -35,6 +35,7 @@ int main(int argc, char* argv[])
     {
     case STATUS::FILE_NOT_OPEN: { puts("Can't open file"); return 1; }
     case STATUS::ZERO_PACKAGES: { puts("Size of packages is zero"); return 1; }
+    case STATUS::ROOTS_NOT_FOUND: { puts("Can't find any of the '-r' objects"); return 1; }
     case STATUS::SUCCESS: { break; }
     default: { return 1; }
     }
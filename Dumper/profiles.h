@@ -0,0 +1,472 @@
+#pragma once
+#include <type_traits>
+#include "engine.h"
+
+// Offsets of the supported engines.
+// They are constexpr so hot code can be instantiated per profile through WithProfile,
+// every field read then folds into an immediate and the branches on offsets a profile
+// does not have (e.g. UStruct.ChildProperties before 4.25) disappear.
+// A profile has to keep the field order of Offsets, it is copied into 'offsets' as is.
+
+inline constexpr struct DefaultOffsets {
+  uint16 Stride = 2;
+  struct {
+    uint16 Size = 24;
+    uint16 Flags = 8;
+  } FUObjectItem;
+  struct {
+    uint16 Number = 4;
+  } FName;
+  struct {
+    uint16 Info = 0;
+    uint16 WideBit = 0;
+    uint16 LenBit = 6;
+    uint16 HeaderSize = 2;
+  } FNameEntry;
+  struct {
+    uint16 Index = 0xC;
+    uint16 Class = 0x10;
+    uint16 Name = 0x18;
+    uint16 Outer = 0x20;
+    uint16 Flags = 0x8;
+  } UObject;
+  struct {
+    uint16 Next = 0x28;
+  } UField;
+  struct {
+    uint16 SuperStruct = 0x40;
+    uint16 Children = 0x48;
+    uint16 ChildProperties = 0x50;
+    uint16 PropertiesSize = 0x58;
+  } UStruct;
+  struct {
+    uint16 Names = 0x40;
+  } UEnum;
+  struct {
+    uint16 FunctionFlags = 0xB0;
+    uint16 Func = 0xB0 + 0x28;
+  } UFunction;
+  struct {
+    uint16 Class = 0x8;
+    uint16 Next = 0x20;
+    uint16 Name = 0x28;
+  } FField;
+  struct {
+    uint16 ArrayDim = 0x38;
+    uint16 ElementSize = 0x3C;
+    uint16 PropertyFlags = 0x40;
+    uint16 Offset = 0x4C;
+    uint16 Size = 0x78;
+  } FProperty;
+  struct {
+    uint16 ArrayDim = 0;
+    uint16 ElementSize = 0;
+    uint16 PropertyFlags = 0;
+    uint16 Offset = 0;
+    uint16 Size = 0; // sizeof(UProperty)
+  } UProperty;
+} Default{};
+static_assert(sizeof(Default) == sizeof(Offsets));
+
+inline constexpr struct SquadOffsets
+{
+    uint16 Stride = 2;
+    struct
+    {
+        uint16 Size = 24;
+        uint16 Flags = 8;
+    } FUObjectItem;
+    struct
+    {
+        uint16 Number = 4;
+    } FName;
+    struct
+    {
+        uint16 Info = 0;
+        uint16 WideBit = 0;
+        uint16 LenBit = 6;
+        uint16 HeaderSize = 2;
+    } FNameEntry;
+    struct
+    {
+        uint16 Index = 0xC;
+        uint16 Class = 0x10;
+        uint16 Name = 0x18;
+        uint16 Outer = 0x20;
+        uint16 Flags = 0x8;
+    } UObject;
+    struct
+    {
+        uint16 Next = 0x28;
+    } UField;
+    struct
+    {
+        uint16 SuperStruct = 0x40;
+        uint16 Children = 0x48;
+        uint16 ChildProperties = 0;
+        uint16 PropertiesSize = 0x50;
+    } UStruct;
+    struct
+    {
+        uint16 Names = 0x40;
+    } UEnum;
+    struct
+    {
+        uint16 FunctionFlags = 0x98;
+        uint16 Func = 0xC0;
+    } UFunction;
+    struct
+    {
+        uint16 Class = 0;
+        uint16 Next = 0;
+        uint16 Name = 0;
+    } FField;
+    struct
+    {
+        uint16 ArrayDim = 0;
+        uint16 ElementSize = 0;
+        uint16 PropertyFlags = 0;
+        uint16 Offset = 0;
+        uint16 Size = 0;
+    } FProperty;
+    struct
+    {
+        uint16 ArrayDim = 0x30;
+        uint16 ElementSize = 0x34;
+        uint16 PropertyFlags = 0x38;
+        uint16 Offset = 0x44;
+        uint16 Size = 0x70; // sizeof(UProperty)
+    } UProperty;
+} Squad{};
+static_assert(sizeof(Squad) == sizeof(Offsets));
+
+inline constexpr struct DeadByDaylightOffsets {
+  uint16 Stride = 4;
+  struct {
+    uint16 Size = 24;
+    uint16 Flags = 8;
+  } FUObjectItem;
+  struct {
+    uint16 Number = 8;
+  } FName;
+  struct {
+    uint16 Info = 4;
+    uint16 WideBit = 0;
+    uint16 LenBit = 1;
+    uint16 HeaderSize = 6;
+  } FNameEntry;
+  struct {
+    uint16 Index = 0xC;
+    uint16 Class = 0x10;
+    uint16 Name = 0x18;
+    uint16 Outer = 0x28;
+    uint16 Flags = 0x8;
+  } UObject;
+  struct {
+    uint16 Next = 0x30;
+  } UField;
+  struct {
+    uint16 SuperStruct = 0x48;
+    uint16 Children = 0x50;
+    uint16 ChildProperties = 0x58;
+    uint16 PropertiesSize = 0x60;
+  } UStruct;
+  struct {
+    uint16 Names = 0x48;
+  } UEnum;
+  struct {
+    uint16 FunctionFlags = 0xB8;
+    uint16 Func = 0xB8 + 0x28; // ue3-ue4, always +0x28 from flags location.
+  } UFunction;
+  struct {
+    uint16 Class = 0x8;
+    uint16 Next = 0x20;
+    uint16 Name = 0x28;
+  } FField;
+  struct {
+    uint16 ArrayDim = 0x38;
+    uint16 ElementSize = 0x3C;
+    uint16 PropertyFlags = 0x40;
+    uint16 Offset = 0x4C;
+    uint16 Size = 0x80;
+  } FProperty;
+  struct {
+    uint16 ArrayDim = 0;
+    uint16 ElementSize = 0;
+    uint16 PropertyFlags = 0;
+    uint16 Offset = 0;
+    uint16 Size = 0; // sizeof(UProperty)
+  } UProperty;
+} DeadByDaylight{};
+static_assert(sizeof(DeadByDaylight) == sizeof(Offsets));
+
+inline constexpr struct ScavengersOffsets {
+  uint16 Stride = 2;
+  struct {
+    uint16 Size = 24;
+    uint16 Flags = 8;
+  } FUObjectItem;
+  struct {
+    uint16 Number = 4;
+  } FName;
+  struct {
+    uint16 Info = 0;
+    uint16 WideBit = 0;
+    uint16 LenBit = 6;
+    uint16 HeaderSize = 2;
+  } FNameEntry;
+  struct {
+    uint16 Index = 0xC;
+    uint16 Class = 0x10;
+    uint16 Name = 0x18;
+    uint16 Outer = 0x20;
+    uint16 Flags = 0x8;
+  } UObject;
+  struct {
+    uint16 Next = 0x28;
+  } UField;
+  struct {
+    uint16 SuperStruct = 0x40;
+    uint16 Children = 0x48;
+    uint16 ChildProperties = 0x50;
+    uint16 PropertiesSize = 0x58;
+  } UStruct;
+  struct {
+    uint16 Names = 0x40;
+  } UEnum;
+  struct {
+    uint16 FunctionFlags = 0xB0;
+    uint16 Func = 0xB0 + 0x30;
+  } UFunction;
+  struct {
+    uint16 Class = 0x8;
+    uint16 Next = 0x20;
+    uint16 Name = 0x28;
+  } FField;
+  struct {
+    uint16 ArrayDim = 0x38;
+    uint16 ElementSize = 0x3C;
+    uint16 PropertyFlags = 0x40;
+    uint16 Offset = 0x4C;
+    uint16 Size = 0x78;
+  } FProperty;
+  struct {
+    uint16 ArrayDim = 0;
+    uint16 ElementSize = 0;
+    uint16 PropertyFlags = 0;
+    uint16 Offset = 0;
+    uint16 Size = 0; // sizeof(UProperty)
+  } UProperty;
+} Scavengers{};
+static_assert(sizeof(Scavengers) == sizeof(Offsets));
+
+inline constexpr struct BrickadiaOffsets {
+  uint16 Stride = 2;
+  struct {
+    uint16 Size = 32;
+    uint16 Flags = 8;
+  } FUObjectItem;
+  struct {
+    uint16 Number = 4;
+  } FName;
+  struct {
+    uint16 Info = 0;
+    uint16 WideBit = 0;
+    uint16 LenBit = 6;
+    uint16 HeaderSize = 2;
+  } FNameEntry;
+  struct {
+    uint16 Index = 0xC;
+    uint16 Class = 0x10;
+    uint16 Name = 0x18;
+    uint16 Outer = 0x20;
+    uint16 Flags = 0x8;
+  } UObject;
+  struct {
+    uint16 Next = 0x28;
+  } UField;
+  struct {
+    uint16 SuperStruct = 0x40;
+    uint16 Children = 0x48;
+    uint16 ChildProperties = 0x50;
+    uint16 PropertiesSize = 0x58;
+  } UStruct;
+  struct {
+    uint16 Names = 0x40;
+  } UEnum;
+  struct {
+    uint16 FunctionFlags = 0xB0;
+    uint16 Func = 0xB0 + 0x28;
+  } UFunction;
+  struct {
+    uint16 Class = 0x8;
+    uint16 Next = 0x20;
+    uint16 Name = 0x28;
+  } FField;
+  struct {
+    uint16 ArrayDim = 0x38;
+    uint16 ElementSize = 0x3C;
+    uint16 PropertyFlags = 0x40;
+    uint16 Offset = 0x4C;
+    uint16 Size = 0x78;
+  } FProperty;
+  struct {
+    uint16 ArrayDim = 0;
+    uint16 ElementSize = 0;
+    uint16 PropertyFlags = 0;
+    uint16 Offset = 0;
+    uint16 Size = 0; // sizeof(UProperty)
+  } UProperty;
+} Brickadia{};
+static_assert(sizeof(Brickadia) == sizeof(Offsets));
+
+inline constexpr struct CoreOffsets {
+  uint16 Stride = 4;
+  struct {
+    uint16 Size = 24;
+    uint16 Flags = 8;
+  } FUObjectItem;
+  struct {
+    uint16 Number = 8;
+  } FName;
+  struct {
+    uint16 Info = 4;
+    uint16 WideBit = 0;
+    uint16 LenBit = 1;
+    uint16 HeaderSize = 6;
+  } FNameEntry;
+  struct {
+    uint16 Index = 0xC;
+    uint16 Class = 0x10;
+    uint16 Name = 0x18;
+    uint16 Outer = 0x28;
+    uint16 Flags = 0x8;
+  } UObject;
+  struct {
+      uint16 Next = 0x30;
+  } UField;
+  struct {
+    uint16 SuperStruct = 0x48;
+    uint16 Children = 0x50;
+    uint16 ChildProperties = 0x58;
+    uint16 PropertiesSize = 0x60;
+  } UStruct;
+  struct {
+    uint16 Names = 0x48;
+  } UEnum;
+  struct {
+    uint16 FunctionFlags = 0xB8;
+    uint16 Func = 0xB8 + 0x28;
+  } UFunction;
+  struct {
+    uint16 Class = 0x8;
+    uint16 Next = 0x20;
+    uint16 Name = 0x28;
+  } FField;
+  struct {
+    uint16 ArrayDim = 0x38;
+    uint16 ElementSize = 0x3C;
+    uint16 PropertyFlags = 0x40;
+    uint16 Offset = 0x4C;
+    uint16 Size = 0x80;
+  } FProperty;
+  struct {
+    uint16 ArrayDim = 0;
+    uint16 ElementSize = 0;
+    uint16 PropertyFlags = 0;
+    uint16 Offset = 0;
+    uint16 Size = 0; // sizeof(UProperty)
+  } UProperty;
+} Core{};
+static_assert(sizeof(Core) == sizeof(Offsets));
+
+inline constexpr struct CalabiyauOffsets {
+  uint16 Stride = 2;
+  struct {
+    uint16 Size = 24;
+    uint16 Flags = 8;
+  } FUObjectItem;
+  struct {
+    uint16 Number = 4;
+  } FName;
+  struct {
+    uint16 Info = 0;
+    uint16 WideBit = 0;
+    uint16 LenBit = 6;
+    uint16 HeaderSize = 2;
+  } FNameEntry;
+  struct {
+    uint16 Index = 0xC;
+    uint16 Class = 0x10;
+    uint16 Name = 0x18;
+    uint16 Outer = 0x20;
+    uint16 Flags = 0x8;
+  } UObject;
+  struct {
+    uint16 Next = 0x28;
+  } UField;
+  struct {
+    uint16 SuperStruct = 0x40;
+    uint16 Children = 0x48;
+    uint16 ChildProperties = 0x50;
+    uint16 PropertiesSize = 0x58;
+  } UStruct;
+  struct {
+    uint16 Names = 0x40;
+  } UEnum;
+  struct {
+    uint16 FunctionFlags = 0xB0;
+    uint16 Func = 0xB0 + 0x28;
+  } UFunction;
+  struct {
+    uint16 Class = 0x8;
+    uint16 Next = 0x20;
+    uint16 Name = 0x28;
+  } FField;
+  struct {
+    uint16 ArrayDim = 0x38;
+    uint16 ElementSize = 0x3C;
+    uint16 PropertyFlags = 0x40;
+    uint16 Offset = 0x4C;
+    uint16 Size = 0x78;
+  } FProperty;
+  struct {
+    uint16 ArrayDim = 0x38;
+    uint16 ElementSize = 0x3C;
+    uint16 PropertyFlags = 0x40;
+    uint16 Offset = 0x4C;
+    uint16 Size = 0x78; // sizeof(UProperty)
+  } UProperty;
+} Calabiyau{};
+static_assert(sizeof(Calabiyau) == sizeof(Offsets));
+
+enum class OffsetsProfile : uint8 {
+  Runtime, // 'offsets' was filled by other means, hot code reads it like the rest of the dumper
+  Default,
+  Squad,
+  DeadByDaylight,
+  Scavengers,
+  Brickadia,
+  Core,
+  Calabiyau
+};
+
+extern OffsetsProfile profile;
+
+// Copies the profile into 'offsets' and makes WithProfile use its instantiation
+void SelectProfile(OffsetsProfile selected);
+
+// Calls fn.template operator()<P>() where P is the selected constexpr profile,
+// or the global 'offsets' for OffsetsProfile::Runtime.
+template <typename Fn> decltype(auto) WithProfile(Fn&& fn) {
+  switch (profile) {
+  case OffsetsProfile::Default: return fn.template operator()<Default>();
+  case OffsetsProfile::Squad: return fn.template operator()<Squad>();
+  case OffsetsProfile::DeadByDaylight: return fn.template operator()<DeadByDaylight>();
+  case OffsetsProfile::Scavengers: return fn.template operator()<Scavengers>();
+  case OffsetsProfile::Brickadia: return fn.template operator()<Brickadia>();
+  case OffsetsProfile::Core: return fn.template operator()<Core>();
+  case OffsetsProfile::Calabiyau: return fn.template operator()<Calabiyau>();
+  }
+  return fn.template operator()<offsets>();
+}
@@ -2,23 +2,10 @@
 #include <winternl.h>
 #include "memory.h"
 #include "utils.h"
-
-bool Compare(uint8* data, uint8 *sig, uint32 size) {
-  for (uint32 i = 0; i < size; i++) {
-    if (data[i] != sig[i] && sig[i] != 0x00) {
-      return false;
-    }
-  }
-  return true;
-}
+#include "SignatureScan.h"
 
 uint8* FindSignature(void* start, void* end, const char* sig, uint32 size) {
-  for (uint8* it = (uint8*)start; it < (uint8*)end - size; it++) {
-    if (Compare(it, (uint8*)sig, size)) {
-      return it;
-    };
-  }
-  return 0;
+  return ScanSignature(start, end, sig, size);
 }
 
 void* FindPointer(void* start, void* end, const char* sig, uint32 size, int32 addition) {
@@ -1,14 +1,24 @@
 #include <Windows.h>
 #include <algorithm>
+#include <cstring>
 #include <fmt/core.h>
+#include <fmt/format.h>
 #include <hash/hash.h>
 #include <algorithm>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include "engine.h"
 #include "memory.h"
 #include "wrappers.h"
 #include "ClassSizeFixer.h"
+#include "DumpScope.h"
 #include "EngineHeaderExport.h"
+#include "ObjectTable.h"
+#include "PropertyChain.h"
+#include "ReflectionClasses.h"
+#include "StringPool.h"
+#include "TaskPool.h"
 #include <cassert>
 
 std::pair<bool, uint16> UE_FNameEntry::Info() const {
@@ -78,11 +88,32 @@ uint16 UE_FNameEntry::Size(bool wide, uint16 len) {
 
 std::string UE_FName::GetName() const {
   uint32 index = Read<uint32>(object);
+  uint32 number = Read<uint32>(object + offsets.FName.Number);
+  return GetName(index, number);
+}
+
+// Decoded strings of the name pool entries seen so far, shared by every name lookup.
+// An entry never changes once it was allocated, so it is read only once.
+static std::string GetEntryString(uint32 index, UE_FNameEntry entry) {
+  static std::mutex lock;
+  static std::unordered_map<uint32, std::string> entryMp;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = entryMp.find(index);
+    if (it != entryMp.end()) return it->second;
+  }
+
+  auto [wide, len] = entry.Info();
+  auto str = entry.String(wide, len);
+  std::lock_guard<std::mutex> guard(lock);
+  entryMp.emplace(index, str);
+  return str;
+}
+
+std::string UE_FName::GetName(uint32 index, uint32 number) {
   auto entry = UE_FNameEntry(NamePoolData.GetEntry(index));
   if (!entry) return std::string();
-  auto [wide, len] = entry.Info();
-  auto name = entry.String(wide, len);
-  uint32 number = Read<uint32>(object + offsets.FName.Number);
+  auto name = GetEntryString(index, entry);
   if (number > 0) {
     name += '_' + std::to_string(number);
   }
@@ -159,13 +190,11 @@ bool UE_UObject::IsA(UE_UClass cmp) const {
 }
 
 UE_UClass UE_UObject::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.Object"));
-  return obj;
+  return ReflectionClasses::Object;
 };
 
 UE_UClass UE_AActor::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class Engine.Actor"));
-  return obj;
+  return ReflectionClasses::Actor;
 }
 
 UE_UField UE_UField::GetNext() const {
@@ -173,87 +202,194 @@ UE_UField UE_UField::GetNext() const {
 }
 
 UE_UClass UE_UField::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.Field"));
-  return obj;
+  return ReflectionClasses::Field;
 };
 
-std::string IUProperty::GetName() const {
-  return ((UE_UProperty*)(this->prop))->GetName();
+int32 UE_UProperty::GetArrayDim() const {
+  return Read<int32>(object + offsets.UProperty.ArrayDim);
 }
 
-int32 IUProperty::GetArrayDim() const {
-  return ((UE_UProperty*)(this->prop))->GetArrayDim();
+int32 UE_UProperty::GetSize() const {
+  return Read<int32>(object + offsets.UProperty.ElementSize);
 }
 
-int32 IUProperty::GetSize() const {
-  return ((UE_UProperty*)(this->prop))->GetSize();
+int32 UE_UProperty::GetOffset() const {
+  return Read<int32>(object + offsets.UProperty.Offset);
 }
 
-int32 IUProperty::GetOffset() const {
-  return ((UE_UProperty*)(this->prop))->GetOffset();
+uint64 UE_UProperty::GetPropertyFlags() const {
+  return Read<uint64>(object + offsets.UProperty.PropertyFlags);
 }
 
-uint64 IUProperty::GetPropertyFlags() const {
-  return ((UE_UProperty*)(this->prop))->GetPropertyFlags();
+bool IsReferenceKind(PropertyType kind) {
+  switch (kind) {
+  case PropertyType::ObjectProperty:
+  case PropertyType::ClassProperty:
+  case PropertyType::SoftObjectProperty:
+  case PropertyType::SoftClassProperty:
+  case PropertyType::WeakObjectProperty:
+  case PropertyType::LazyObjectProperty:
+  case PropertyType::InterfaceProperty:
+  case PropertyType::FieldPathProperty:
+    return true;
+  default:
+    return false;
+  }
 }
 
-std::pair<PropertyType, std::string> IUProperty::GetType() const {
-  return ((UE_UProperty*)(this->prop))->GetType();
+// Name of an FFieldClass, field path properties of one process share a handful of them
+static std::string GetFieldClassName(uint8* cls) {
+  static std::mutex lock;
+  static std::unordered_map<uint8*, std::string> nameMp;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = nameMp.find(cls);
+    if (it != nameMp.end()) return it->second;
+  }
+  auto name = UE_FFieldClass(cls).GetName();
+  std::lock_guard<std::mutex> guard(lock);
+  nameMp.emplace(cls, name);
+  return name;
 }
 
-uint8 IUProperty::GetFieldMask() const {
-  return ((UE_UBoolProperty *)(this->prop))->GetFieldMask();
-}
+TypeRef ResolveReferenceType(PropertyType kind, const uint8* extra) {
+  // PropertyClass, Struct, InterfaceClass or the FFieldClass of a field path comes
+  // first, MetaClass of class properties right after it
+  uint8* first;
+  uint8* second;
+  memcpy(&first, extra, sizeof(first));
+  memcpy(&second, extra + 8, sizeof(second));
+  auto structOf = [](uint8* object, TypeKeyword keyword, uint8 pointer) {
+    auto index = ObjTable.IndexOf(object);
+    return TypeTable::Struct(index, ObjTable.GetCppName(index), keyword, pointer);
+  };
 
-int32 UE_UProperty::GetArrayDim() const {
-  return Read<int32>(object + offsets.UProperty.ArrayDim);
+  switch (kind) {
+  case PropertyType::ObjectProperty:
+    return structOf(first, TypeKeyword::Struct, 1);
+  case PropertyType::ClassProperty:
+    return structOf(second, TypeKeyword::Struct, 1);
+  case PropertyType::WeakObjectProperty:
+    return TypeTable::Template("TWeakObjectPtr", { structOf(first, TypeKeyword::Struct, 0) });
+  case PropertyType::LazyObjectProperty:
+    return TypeTable::Template("TLazyObjectPtr", { structOf(first, TypeKeyword::None, 0) });
+  case PropertyType::SoftObjectProperty:
+    return TypeTable::Template("TSoftObjectPtr", { structOf(first, TypeKeyword::None, 0) });
+  case PropertyType::SoftClassProperty: {
+    if (!second) {
+      static const auto type = TypeTable::Template("TSoftClassPtr", { TypeTable::Basic("UObject") });
+      return type;
+    }
+    return TypeTable::Template("TSoftClassPtr", { structOf(second, TypeKeyword::None, 0) });
+  }
+  case PropertyType::InterfaceProperty:
+    return TypeTable::Template("TScriptInterface", { TypeTable::Basic("I" + ObjTable.GetName(ObjTable.IndexOf(first))) });
+  case PropertyType::FieldPathProperty:
+    return TypeTable::Template("TFieldPath", { TypeTable::Basic("F" + GetFieldClassName(first)) });
+  default:
+    return 0;
+  }
 }
 
-int32 UE_UProperty::GetSize() const {
-  return Read<int32>(object + offsets.UProperty.ElementSize);
-}
+// Property classes in the order UE_UProperty::GetType has to test them,
+// a property takes the first entry its class derives from
+struct UPropertyKind {
+  UE_UClass (*StaticClass)();
+  PropertyType Type;
+  TypeRef (*GetTypeRef)(const UE_UProperty& prop);
 
-int32 UE_UProperty::GetOffset() const {
-  return Read<int32>(object + offsets.UProperty.Offset);
+  template <typename T> static UPropertyKind Of(PropertyType type) {
+    return { T::StaticClass, type, [](const UE_UProperty& prop) { return prop.Cast<T>().GetTypeRef(); } };
+  }
+
+  // Reference-like kinds are resolved by ResolveReferenceType
+  template <typename T> static UPropertyKind Reference(PropertyType type) {
+    return { T::StaticClass, type, nullptr };
+  }
+};
+
+static const UPropertyKind UPropertyKinds[] = {
+  UPropertyKind::Of<UE_UDoubleProperty>(PropertyType::DoubleProperty),
+  UPropertyKind::Of<UE_UFloatProperty>(PropertyType::FloatProperty),
+  UPropertyKind::Of<UE_UIntProperty>(PropertyType::IntProperty),
+  UPropertyKind::Of<UE_UInt16Property>(PropertyType::Int16Property),
+  UPropertyKind::Of<UE_UInt64Property>(PropertyType::Int64Property),
+  UPropertyKind::Of<UE_UInt8Property>(PropertyType::Int8Property),
+  UPropertyKind::Of<UE_UUInt16Property>(PropertyType::UInt16Property),
+  UPropertyKind::Of<UE_UUInt32Property>(PropertyType::UInt32Property),
+  UPropertyKind::Of<UE_UUInt64Property>(PropertyType::UInt64Property),
+  UPropertyKind::Of<UE_UTextProperty>(PropertyType::TextProperty),
+  UPropertyKind::Of<UE_UStrProperty>(PropertyType::StrProperty),
+  UPropertyKind::Reference<UE_UClassProperty>(PropertyType::ClassProperty),
+  UPropertyKind::Of<UE_UStructProperty>(PropertyType::StructProperty),
+  UPropertyKind::Of<UE_UNameProperty>(PropertyType::NameProperty),
+  UPropertyKind::Of<UE_UBoolProperty>(PropertyType::BoolProperty),
+  UPropertyKind::Of<UE_UByteProperty>(PropertyType::ByteProperty),
+  UPropertyKind::Of<UE_UArrayProperty>(PropertyType::ArrayProperty),
+  UPropertyKind::Of<UE_UEnumProperty>(PropertyType::EnumProperty),
+  UPropertyKind::Of<UE_USetProperty>(PropertyType::SetProperty),
+  UPropertyKind::Of<UE_UMapProperty>(PropertyType::MapProperty),
+  UPropertyKind::Reference<UE_UInterfaceProperty>(PropertyType::InterfaceProperty),
+  UPropertyKind::Of<UE_UMulticastDelegateProperty>(PropertyType::MulticastDelegateProperty),
+  UPropertyKind::Reference<UE_UWeakObjectProperty>(PropertyType::WeakObjectProperty),
+  UPropertyKind::Reference<UE_ULazyObjectProperty>(PropertyType::LazyObjectProperty),
+  UPropertyKind::Reference<UE_USoftClassProperty>(PropertyType::SoftClassProperty),
+  UPropertyKind::Reference<UE_USoftObjectProperty>(PropertyType::SoftObjectProperty),
+  UPropertyKind::Reference<UE_UObjectPropertyBase>(PropertyType::ObjectProperty),
+};
+
+// Index into UPropertyKinds for every property class seen so far, -1 if none matches
+static int32 GetUPropertyKind(UE_UClass cls) {
+  static std::mutex lock;
+  static std::unordered_map<uint8*, int32> kindMp;
+  static const auto kindClasses = [] {
+    std::vector<UE_UClass> classes;
+    for (auto& kind : UPropertyKinds) classes.push_back(kind.StaticClass());
+    return classes;
+  }();
+
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = kindMp.find(cls);
+    if (it != kindMp.end()) return it->second;
+  }
+
+  std::vector<UE_UClass> supers;
+  for (auto super = cls; super; super = super.GetSuper().Cast<UE_UClass>()) {
+    supers.push_back(super);
+  }
+  int32 kind = -1;
+  for (int32 i = 0; i < (int32)kindClasses.size() && kind == -1; i++) {
+    if (!kindClasses[i]) continue;
+    if (std::find(supers.begin(), supers.end(), kindClasses[i]) != supers.end()) kind = i;
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  kindMp[cls] = kind;
+  return kind;
 }
 
-uint64 UE_UProperty::GetPropertyFlags() const {
-  return Read<uint64>(object + offsets.UProperty.PropertyFlags);
+PropertyType UE_UProperty::KindOf(UE_UClass cls) {
+  auto kind = GetUPropertyKind(cls);
+  if (kind == -1) return PropertyType::Unknown;
+  return UPropertyKinds[kind].Type;
 }
 
-std::pair<PropertyType, std::string> UE_UProperty::GetType() const {
-  if (IsA<UE_UDoubleProperty>()) { return {PropertyType::DoubleProperty,Cast<UE_UDoubleProperty>().GetTypeStr()}; };
-  if (IsA<UE_UFloatProperty>()) { return {PropertyType::FloatProperty, Cast<UE_UFloatProperty>().GetTypeStr()}; };
-  if (IsA<UE_UIntProperty>()) { return {PropertyType::IntProperty, Cast<UE_UIntProperty>().GetTypeStr()}; };
-  if (IsA<UE_UInt16Property>()) { return {PropertyType::Int16Property,Cast<UE_UInt16Property>().GetTypeStr()}; };
-  if (IsA<UE_UInt64Property>()) { return {PropertyType::Int64Property, Cast<UE_UInt64Property>().GetTypeStr()}; };
-  if (IsA<UE_UInt8Property>()) { return {PropertyType::Int8Property, Cast<UE_UInt8Property>().GetTypeStr()}; };
-  if (IsA<UE_UUInt16Property>()) { return {PropertyType::UInt16Property, Cast<UE_UUInt16Property>().GetTypeStr()}; };
-  if (IsA<UE_UUInt32Property>()) { return {PropertyType::UInt32Property, Cast<UE_UUInt32Property>().GetTypeStr()}; }
-  if (IsA<UE_UUInt64Property>()) { return {PropertyType::UInt64Property, Cast<UE_UUInt64Property>().GetTypeStr()}; };
-  if (IsA<UE_UTextProperty>()) { return {PropertyType::TextProperty, Cast<UE_UTextProperty>().GetTypeStr()}; }
-  if (IsA<UE_UStrProperty>()) { return {PropertyType::TextProperty, Cast<UE_UStrProperty>().GetTypeStr()}; };
-  if (IsA<UE_UClassProperty>()) { return {PropertyType::ClassProperty, Cast<UE_UClassProperty>().GetTypeStr()}; };
-  if (IsA<UE_UStructProperty>()) { return {PropertyType::StructProperty, Cast<UE_UStructProperty>().GetTypeStr()}; };
-  if (IsA<UE_UNameProperty>()) { return {PropertyType::NameProperty, Cast<UE_UNameProperty>().GetTypeStr()}; };
-  if (IsA<UE_UBoolProperty>()) { return {PropertyType::BoolProperty, Cast<UE_UBoolProperty>().GetTypeStr()}; }
-  if (IsA<UE_UByteProperty>()) { return {PropertyType::ByteProperty, Cast<UE_UByteProperty>().GetTypeStr()}; };
-  if (IsA<UE_UArrayProperty>()) { return {PropertyType::ArrayProperty, Cast<UE_UArrayProperty>().GetTypeStr()}; };
-  if (IsA<UE_UEnumProperty>()) { return {PropertyType::EnumProperty, Cast<UE_UEnumProperty>().GetTypeStr()}; };
-  if (IsA<UE_USetProperty>()) { return {PropertyType::SetProperty, Cast<UE_USetProperty>().GetTypeStr()}; };
-  if (IsA<UE_UMapProperty>()) { return {PropertyType::MapProperty, Cast<UE_UMapProperty>().GetTypeStr()}; };
-  if (IsA<UE_UInterfaceProperty>()) { return {PropertyType::InterfaceProperty, Cast<UE_UInterfaceProperty>().GetTypeStr()}; };
-  if (IsA<UE_UMulticastDelegateProperty>()) { return {PropertyType::MulticastDelegateProperty, Cast<UE_UMulticastDelegateProperty>().GetTypeStr()}; };
-  if (IsA<UE_UWeakObjectProperty>()) { return { PropertyType::WeakObjectProperty, Cast<UE_UWeakObjectProperty>().GetTypeStr() }; };
-  if (IsA<UE_UObjectPropertyBase>()) { return {PropertyType::ObjectProperty, Cast<UE_UObjectPropertyBase>().GetTypeStr()}; };
-  return {PropertyType::Unknown, GetClass().GetName()};
-}
-
-IUProperty UE_UProperty::GetInterface() const { return IUProperty(this); }
+std::pair<PropertyType, TypeRef> UE_UProperty::GetType() const {
+  auto cls = GetClass();
+  auto kind = GetUPropertyKind(cls);
+  if (kind == -1) return {PropertyType::Unknown, TypeTable::Basic(cls.GetName())};
+  auto& entry = UPropertyKinds[kind];
+  if (IsReferenceKind(entry.Type)) {
+    uint8 extra[PropertyExtraSize]{};
+    Read(object + offsets.UProperty.Size, extra, sizeof(extra));
+    return {entry.Type, ResolveReferenceType(entry.Type, extra)};
+  }
+  return {entry.Type, entry.GetTypeRef(*this)};
+}
 
 UE_UClass UE_UProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.Property"));
-  return obj;
+  return ReflectionClasses::Property;
 }
 
 UE_UStruct UE_UStruct::GetSuper() const {
@@ -274,8 +410,7 @@ int32 UE_UStruct::GetSize() const {
 };
 
 UE_UClass UE_UStruct::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.Struct"));
-  return obj;
+  return ReflectionClasses::Struct;
 };
 
 uint64 UE_UFunction::GetFunc() const {
@@ -491,18 +626,15 @@ std::string UE_UFunction::GetFunctionFlags() const {
 }
 
 UE_UClass UE_UFunction::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.Function"));
-  return obj;
+  return ReflectionClasses::Function;
 }
 
 UE_UClass UE_UScriptStruct::StaticClass() {
-  static UE_UClass obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.ScriptStruct"));
-  return obj;
+  return ReflectionClasses::ScriptStruct;
 };
 
 UE_UClass UE_UClass::StaticClass() {
-  static UE_UClass obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.Class"));
-  return obj;
+  return ReflectionClasses::Class;
 };
 
 TArray UE_UEnum::GetNames() const {
@@ -510,201 +642,210 @@ TArray UE_UEnum::GetNames() const {
 }
 
 UE_UClass UE_UEnum::StaticClass() {
-  static UE_UClass obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.Enum"));
-  return obj;
+  return ReflectionClasses::Enum;
 }
 
-std::string UE_UDoubleProperty::GetTypeStr() const { return "double"; }
+TypeRef UE_UDoubleProperty::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("double");
+  return type;
+}
 
 UE_UClass UE_UDoubleProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.DoubleProperty"));
-  return obj;
+  return ReflectionClasses::DoubleProperty;
 }
 
 UE_UStruct UE_UStructProperty::GetStruct() const {
   return Read<UE_UStruct>(object + offsets.UProperty.Size);
 }
 
-std::string UE_UStructProperty::GetTypeStr() const {
-  return "struct " + GetStruct().GetCppName();
+TypeRef UE_UStructProperty::GetTypeRef() const {
+  auto s = GetStruct();
+  return TypeTable::Struct(ObjTable.IndexOf(s), s.GetCppName());
 }
 
 UE_UClass UE_UStructProperty::StaticClass() {
-  static auto obj = (UE_UClass)( ObjObjects.FindObject("Class CoreUObject.StructProperty"));
-  return obj;
+  return ReflectionClasses::StructProperty;
 }
 
-std::string UE_UNameProperty::GetTypeStr() const { return "struct FName"; }
+TypeRef UE_UNameProperty::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("FName", TypeKeyword::Struct);
+  return type;
+}
 
 UE_UClass UE_UNameProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.NameProperty"));
-  return obj;
+  return ReflectionClasses::NameProperty;
 }
 
 UE_UClass UE_UObjectPropertyBase::GetPropertyClass() const {
   return Read<UE_UClass>(object + offsets.UProperty.Size);
 }
 
-std::string UE_UObjectPropertyBase::GetTypeStr() const {
-  return "struct " + GetPropertyClass().GetCppName() + "*";
-}
-
 UE_UClass UE_UObjectPropertyBase::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.ObjectPropertyBase"));
-  return obj;
+  return ReflectionClasses::ObjectPropertyBase;
 }
 
 UE_UProperty UE_UArrayProperty::GetInner() const {
   return Read<UE_UProperty>(object + offsets.UProperty.Size);
 }
 
-std::string UE_UArrayProperty::GetTypeStr() const {
-  return "struct TArray<" + GetInner().GetType().second + ">";
+TypeRef UE_UArrayProperty::GetTypeRef() const {
+  return TypeTable::Template("TArray", { GetInner().GetType().second });
 }
 
 UE_UClass UE_UArrayProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.ArrayProperty"));
-  return obj;
+  return ReflectionClasses::ArrayProperty;
 }
 
 UE_UEnum UE_UByteProperty::GetEnum() const {
   return Read<UE_UEnum>(object + offsets.UProperty.Size);
 }
 
-std::string UE_UByteProperty::GetTypeStr() const {
+TypeRef UE_UByteProperty::GetTypeRef() const {
   auto e = GetEnum();
-  if (e) return "enum class " + e.GetName();
-  return "char";
+  if (e) return TypeTable::Enum(ObjTable.IndexOf(e), e.GetName());
+  return TypeTable::Basic("char");
 }
 
 UE_UClass UE_UByteProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.ByteProperty"));
-  return obj;
+  return ReflectionClasses::ByteProperty;
 }
 
 uint8 UE_UBoolProperty::GetFieldMask() const {
   return Read<uint8>(object + offsets.UProperty.Size + 3);
 }
 
-std::string UE_UBoolProperty::GetTypeStr() const {
+TypeRef UE_UBoolProperty::GetTypeRef() const {
   if (GetFieldMask() == 0xFF) {
-    return "bool";
+    return TypeTable::Basic("bool");
   };
-  return "char";
+  return TypeTable::Basic("char");
 }
 
 UE_UClass UE_UBoolProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.BoolProperty"));
-  return obj;
+  return ReflectionClasses::BoolProperty;
 }
 
-std::string UE_UFloatProperty::GetTypeStr() const { return "float"; }
+TypeRef UE_UFloatProperty::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("float");
+  return type;
+}
 
 UE_UClass UE_UFloatProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.FloatProperty"));
-  return obj;
+  return ReflectionClasses::FloatProperty;
 }
 
-std::string UE_UIntProperty::GetTypeStr() const { return "int"; }
+TypeRef UE_UIntProperty::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("int");
+  return type;
+}
 
 UE_UClass UE_UIntProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.IntProperty"));
-  return obj;
+  return ReflectionClasses::IntProperty;
 }
 
-std::string UE_UInt16Property::GetTypeStr() const { return "int16"; }
+TypeRef UE_UInt16Property::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("int16");
+  return type;
+}
 
 UE_UClass UE_UInt16Property::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.Int16Property"));
-  return obj;
+  return ReflectionClasses::Int16Property;
 }
 
-std::string UE_UInt64Property::GetTypeStr() const { return "int64"; }
+TypeRef UE_UInt64Property::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("int64");
+  return type;
+}
 
 UE_UClass UE_UInt64Property::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.Int64Property"));
-  return obj;
+  return ReflectionClasses::Int64Property;
 }
 
-std::string UE_UInt8Property::GetTypeStr() const { return "uint8"; }
+TypeRef UE_UInt8Property::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("uint8");
+  return type;
+}
 
 UE_UClass UE_UInt8Property::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.Int8Property"));
-  return obj;
+  return ReflectionClasses::Int8Property;
 }
 
-std::string UE_UUInt16Property::GetTypeStr() const { return "uint16"; }
+TypeRef UE_UUInt16Property::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("uint16");
+  return type;
+}
 
 UE_UClass UE_UUInt16Property::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.UInt16Property"));
-  return obj;
+  return ReflectionClasses::UInt16Property;
 }
 
-std::string UE_UUInt32Property::GetTypeStr() const { return "uint32"; }
+TypeRef UE_UUInt32Property::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("uint32");
+  return type;
+}
 
 UE_UClass UE_UUInt32Property::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.UInt32Property"));
-  return obj;
+  return ReflectionClasses::UInt32Property;
 }
 
-std::string UE_UUInt64Property::GetTypeStr() const { return "uint64"; }
+TypeRef UE_UUInt64Property::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("uint64");
+  return type;
+}
 
 UE_UClass UE_UUInt64Property::StaticClass() {
-  static auto obj = (UE_UClass)( ObjObjects.FindObject("Class CoreUObject.UInt64Property"));
-  return obj;
+  return ReflectionClasses::UInt64Property;
 }
 
-std::string UE_UTextProperty::GetTypeStr() const { return "struct FText"; }
+TypeRef UE_UTextProperty::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("FText", TypeKeyword::Struct);
+  return type;
+}
 
 UE_UClass UE_UTextProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.TextProperty"));
-  return obj;
+  return ReflectionClasses::TextProperty;
 }
 
-std::string UE_UStrProperty::GetTypeStr() const { return "struct FString"; }
+TypeRef UE_UStrProperty::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("FString", TypeKeyword::Struct);
+  return type;
+}
 
 UE_UClass UE_UStrProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.StrProperty"));
-  return obj;
+  return ReflectionClasses::StrProperty;
 }
 
 UE_UClass UE_UEnumProperty::GetEnum() const {
   return Read<UE_UClass>(object + offsets.UProperty.Size + 8);
 }
 
-std::string UE_UEnumProperty::GetTypeStr() const {
-  return "enum class " + GetEnum().GetName();
+TypeRef UE_UEnumProperty::GetTypeRef() const {
+  auto e = GetEnum();
+  return TypeTable::Enum(ObjTable.IndexOf(e), e.GetName());
 }
 
 UE_UClass UE_UEnumProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.EnumProperty"));
-  return obj;
+  return ReflectionClasses::EnumProperty;
 }
 
 UE_UClass UE_UClassProperty::GetMetaClass() const {
   return Read<UE_UClass>(object + offsets.UProperty.Size + 8);
 }
 
-std::string UE_UClassProperty::GetTypeStr() const {
-  return "struct " + GetMetaClass().GetCppName() + "*";
-}
-
 UE_UClass UE_UClassProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.ClassProperty"));
-  return obj;
+  return ReflectionClasses::ClassProperty;
 }
 
 UE_UProperty UE_USetProperty::GetElementProp() const {
   return Read<UE_UProperty>(object + offsets.UProperty.Size);
 }
 
-std::string UE_USetProperty::GetTypeStr() const {
-  return "struct TSet<" + GetElementProp().GetType().second + ">";
+TypeRef UE_USetProperty::GetTypeRef() const {
+  return TypeTable::Template("TSet", { GetElementProp().GetType().second });
 }
 
 UE_UClass UE_USetProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.SetProperty"));
-  return obj;
+  return ReflectionClasses::SetProperty;
 }
 
 UE_UProperty UE_UMapProperty::GetKeyProp() const {
@@ -715,44 +856,45 @@ UE_UProperty UE_UMapProperty::GetValueProp() const {
   return Read<UE_UProperty>(object + offsets.UProperty.Size + 8);
 }
 
-std::string UE_UMapProperty::GetTypeStr() const {
-  return fmt::format("struct TMap<{}, {}>", GetKeyProp().GetType().second, GetValueProp().GetType().second);
+TypeRef UE_UMapProperty::GetTypeRef() const {
+  return TypeTable::Template("TMap", { GetKeyProp().GetType().second, GetValueProp().GetType().second });
 }
 
 UE_UClass UE_UMapProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.MapProperty"));
-  return obj;
-}
-
-UE_UProperty UE_UInterfaceProperty::GetInterfaceClass() const {
-  return Read<UE_UProperty>(object + offsets.UProperty.Size);
+  return ReflectionClasses::MapProperty;
 }
 
-std::string UE_UInterfaceProperty::GetTypeStr() const {
-  return "struct TScriptInterface<" + GetInterfaceClass().GetType().second + ">";
+UE_UClass UE_UInterfaceProperty::GetInterfaceClass() const {
+  return Read<UE_UClass>(object + offsets.UProperty.Size);
 }
 
 UE_UClass UE_UInterfaceProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.InterfaceProperty"));
-  return obj;
+  return ReflectionClasses::InterfaceProperty;
 }
 
-std::string UE_UMulticastDelegateProperty::GetTypeStr() const {
-  return "struct FScriptMulticastDelegate";
+TypeRef UE_UMulticastDelegateProperty::GetTypeRef() const {
+  static const auto type = TypeTable::Basic("FScriptMulticastDelegate", TypeKeyword::Struct);
+  return type;
 }
 
 UE_UClass UE_UMulticastDelegateProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.MulticastDelegateProperty"));
-  return obj;
+  return ReflectionClasses::MulticastDelegateProperty;
 }
 
-std::string UE_UWeakObjectProperty::GetTypeStr() const {
-  return "struct TWeakObjectPtr<" + this->Cast<UE_UStructProperty>().GetTypeStr() + ">";
+UE_UClass UE_UWeakObjectProperty::StaticClass() {
+  return ReflectionClasses::WeakObjectProperty;
 }
 
-UE_UClass UE_UWeakObjectProperty::StaticClass() {
-  static auto obj = (UE_UClass)(ObjObjects.FindObject("Class CoreUObject.WeakObjectProperty"));
-  return obj;
+UE_UClass UE_ULazyObjectProperty::StaticClass() {
+  return ReflectionClasses::LazyObjectProperty;
+}
+
+UE_UClass UE_USoftObjectProperty::StaticClass() {
+  return ReflectionClasses::SoftObjectProperty;
+}
+
+UE_UClass UE_USoftClassProperty::StaticClass() {
+  return ReflectionClasses::SoftClassProperty;
 }
 
 std::string UE_FFieldClass::GetName() const {
@@ -769,32 +911,6 @@ std::string UE_FField::GetName() const {
   return name.GetName();
 }
 
-std::string IFProperty::GetName() const {
-  return ((UE_FProperty *)prop)->GetName();
-}
-
-int32 IFProperty::GetArrayDim() const {
-  return ((UE_FProperty*)prop)->GetArrayDim();
-}
-
-int32 IFProperty::GetSize() const { return ((UE_FProperty *)prop)->GetSize(); }
-
-int32 IFProperty::GetOffset() const {
-  return ((UE_FProperty*)prop)->GetOffset();
-}
-
-uint64 IFProperty::GetPropertyFlags() const {
-  return ((UE_FProperty*)prop)->GetPropertyFlags();
-}
-
-std::pair<PropertyType, std::string> IFProperty::GetType() const {
-  return ((UE_FProperty*)prop)->GetType();
-}
-
-uint8 IFProperty::GetFieldMask() const {
-  return ((UE_FBoolProperty *)prop)->GetFieldMask();
-}
-
 int32 UE_FProperty::GetArrayDim() const {
   return Read<int32>(object + offsets.FProperty.ArrayDim);
 }
@@ -811,145 +927,186 @@ uint64 UE_FProperty::GetPropertyFlags() const {
   return Read<uint64>(object + offsets.FProperty.PropertyFlags);
 }
 
+// PropertyType of every FFieldClass seen so far, a process only has a few dozens of them
+PropertyType UE_FProperty::KindOf(UE_FFieldClass cls) {
+  static std::mutex lock;
+  static std::unordered_map<void*, PropertyType> kindMp;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = kindMp.find(cls.GetAddress());
+    if (it != kindMp.end()) return it->second;
+  }
+
+  auto name = cls.GetName();
+  auto kind = PropertyType::Unknown;
+  switch (Hash(name.c_str(), name.size())) {
+  case HASH("StructProperty"): kind = PropertyType::StructProperty; break;
+  case HASH("ObjectProperty"): kind = PropertyType::ObjectProperty; break;
+  case HASH("SoftObjectProperty"): kind = PropertyType::SoftObjectProperty; break;
+  case HASH("FloatProperty"): kind = PropertyType::FloatProperty; break;
+  case HASH("ByteProperty"): kind = PropertyType::ByteProperty; break;
+  case HASH("BoolProperty"): kind = PropertyType::BoolProperty; break;
+  case HASH("IntProperty"): kind = PropertyType::IntProperty; break;
+  case HASH("Int8Property"): kind = PropertyType::Int8Property; break;
+  case HASH("Int16Property"): kind = PropertyType::Int16Property; break;
+  case HASH("Int64Property"): kind = PropertyType::Int64Property; break;
+  case HASH("UInt16Property"): kind = PropertyType::UInt16Property; break;
+  case HASH("UInt32Property"): kind = PropertyType::UInt32Property; break;
+  case HASH("UInt64Property"): kind = PropertyType::UInt64Property; break;
+  case HASH("NameProperty"): kind = PropertyType::NameProperty; break;
+  case HASH("DelegateProperty"): kind = PropertyType::DelegateProperty; break;
+  case HASH("SetProperty"): kind = PropertyType::SetProperty; break;
+  case HASH("ArrayProperty"): kind = PropertyType::ArrayProperty; break;
+  case HASH("WeakObjectProperty"): kind = PropertyType::WeakObjectProperty; break;
+  case HASH("StrProperty"): kind = PropertyType::StrProperty; break;
+  case HASH("TextProperty"): kind = PropertyType::TextProperty; break;
+  case HASH("MulticastSparseDelegateProperty"): kind = PropertyType::MulticastSparseDelegateProperty; break;
+  case HASH("EnumProperty"): kind = PropertyType::EnumProperty; break;
+  case HASH("DoubleProperty"): kind = PropertyType::DoubleProperty; break;
+  case HASH("MulticastDelegateProperty"): kind = PropertyType::MulticastDelegateProperty; break;
+  case HASH("ClassProperty"): kind = PropertyType::ClassProperty; break;
+  case HASH("MulticastInlineDelegateProperty"): kind = PropertyType::MulticastInlineDelegateProperty; break;
+  case HASH("MapProperty"): kind = PropertyType::MapProperty; break;
+  case HASH("InterfaceProperty"): kind = PropertyType::InterfaceProperty; break;
+  case HASH("FieldPathProperty"): kind = PropertyType::FieldPathProperty; break;
+  case HASH("SoftClassProperty"): kind = PropertyType::SoftClassProperty; break;
+  case HASH("LazyObjectProperty"): kind = PropertyType::LazyObjectProperty; break;
+  }
+
+  std::lock_guard<std::mutex> guard(lock);
+  kindMp[cls.GetAddress()] = kind;
+  return kind;
+}
+
 type UE_FProperty::GetType() const {
   auto objectClass = Read<UE_FFieldClass>(object + offsets.FField.Class);
-  type type = {PropertyType::Unknown, objectClass.GetName()};
+  type type = {PropertyType::Unknown, 0};
 
-  auto& str = type.second;
-  auto hash = Hash(str.c_str(), str.size());
-  switch (hash) {
-  case HASH("StructProperty"): {
-    auto obj = this->Cast<UE_FStructProperty>();
-    type = { PropertyType::StructProperty, obj.GetTypeStr() };
-    break;
-  }
-  case HASH("ObjectProperty"): {
-    auto obj = this->Cast<UE_FObjectPropertyBase>();
-    type = { PropertyType::ObjectProperty, obj.GetTypeStr() };
-    break;
+  auto kind = KindOf(objectClass);
+  if (IsReferenceKind(kind)) {
+    uint8 extra[PropertyExtraSize]{};
+    Read(object + offsets.FProperty.Size, extra, sizeof(extra));
+    return { kind, ResolveReferenceType(kind, extra) };
   }
-  case HASH("SoftObjectProperty"): {
-    auto obj = this->Cast<UE_FObjectPropertyBase>();
-    type = { PropertyType::SoftObjectProperty, "struct TSoftObjectPtr<" + obj.GetPropertyClass().GetCppName() + ">" };
+
+  switch (kind) {
+  case PropertyType::StructProperty: {
+    auto obj = this->Cast<UE_FStructProperty>();
+    type = { PropertyType::StructProperty, obj.GetTypeRef() };
     break;
   }
-  case HASH("FloatProperty"): {
-    type = { PropertyType::FloatProperty, "float" };
+  case PropertyType::FloatProperty: {
+    static const auto ref = TypeTable::Basic("float");
+    type = { PropertyType::FloatProperty, ref };
     break;
   }
-  case HASH("ByteProperty"): {
+  case PropertyType::ByteProperty: {
     auto obj = this->Cast<UE_FByteProperty>();
-    type = { PropertyType::ByteProperty, obj.GetTypeStr() };
+    type = { PropertyType::ByteProperty, obj.GetTypeRef() };
     break;
   }
-  case HASH("BoolProperty"): {
+  case PropertyType::BoolProperty: {
     auto obj = this->Cast<UE_FBoolProperty>();
-    type = { PropertyType::BoolProperty, obj.GetTypeStr() };
+    type = { PropertyType::BoolProperty, obj.GetTypeRef() };
     break;
   }
-  case HASH("IntProperty"): {
-    type = { PropertyType::IntProperty, "int32_t" };
+  case PropertyType::IntProperty: {
+    static const auto ref = TypeTable::Basic("int32_t");
+    type = { PropertyType::IntProperty, ref };
     break;
   }
-  case HASH("Int8Property"): {
-    type = { PropertyType::Int8Property, "int8_t" };
+  case PropertyType::Int8Property: {
+    static const auto ref = TypeTable::Basic("int8_t");
+    type = { PropertyType::Int8Property, ref };
     break;
   }
-  case HASH("Int16Property"): {
-    type = { PropertyType::Int16Property, "int16_t" };
+  case PropertyType::Int16Property: {
+    static const auto ref = TypeTable::Basic("int16_t");
+    type = { PropertyType::Int16Property, ref };
     break;
   }
-  case HASH("Int64Property"): {
-    type = { PropertyType::Int64Property, "int64_t" };
+  case PropertyType::Int64Property: {
+    static const auto ref = TypeTable::Basic("int64_t");
+    type = { PropertyType::Int64Property, ref };
     break;
   }
-  case HASH("UInt16Property"): {
-    type = { PropertyType::UInt16Property, "uint16_t" };
+  case PropertyType::UInt16Property: {
+    static const auto ref = TypeTable::Basic("uint16_t");
+    type = { PropertyType::UInt16Property, ref };
     break;
   }
-  case HASH("UInt32Property"): {
-    type = { PropertyType::UInt32Property, "uint32_t" };
+  case PropertyType::UInt32Property: {
+    static const auto ref = TypeTable::Basic("uint32_t");
+    type = { PropertyType::UInt32Property, ref };
     break;
   }
-  case HASH("UInt64Property"): {
-    type = { PropertyType::UInt64Property, "uint64_t" };
+  case PropertyType::UInt64Property: {
+    static const auto ref = TypeTable::Basic("uint64_t");
+    type = { PropertyType::UInt64Property, ref };
     break;
   }
-  case HASH("NameProperty"): {
-    type = { PropertyType::NameProperty, "struct FName" };
+  case PropertyType::NameProperty: {
+    static const auto ref = TypeTable::Basic("FName", TypeKeyword::Struct);
+    type = { PropertyType::NameProperty, ref };
     break;
   }
-  case HASH("DelegateProperty"): {
-    type = { PropertyType::DelegateProperty, "struct FDelegate" };
+  case PropertyType::DelegateProperty: {
+    static const auto ref = TypeTable::Basic("FDelegate", TypeKeyword::Struct);
+    type = { PropertyType::DelegateProperty, ref };
     break;
   }
-  case HASH("SetProperty"): {
+  case PropertyType::SetProperty: {
     auto obj = this->Cast<UE_FSetProperty>();
-    type = { PropertyType::SetProperty, obj.GetTypeStr() };
+    type = { PropertyType::SetProperty, obj.GetTypeRef() };
     break;
   }
-  case HASH("ArrayProperty"): {
+  case PropertyType::ArrayProperty: {
     auto obj = this->Cast<UE_FArrayProperty>();
-    type = { PropertyType::ArrayProperty, obj.GetTypeStr() };
-    break;
-  }
-  case HASH("WeakObjectProperty"): {
-    auto obj = this->Cast<UE_FStructProperty>();
-    type = { PropertyType::WeakObjectProperty, "struct TWeakObjectPtr<" + obj.GetTypeStr() + ">" };
-
+    type = { PropertyType::ArrayProperty, obj.GetTypeRef() };
     break;
   }
-  case HASH("StrProperty"): {
-    type = { PropertyType::StrProperty, "struct FString" };
+  case PropertyType::StrProperty: {
+    static const auto ref = TypeTable::Basic("FString", TypeKeyword::Struct);
+    type = { PropertyType::StrProperty, ref };
     break;
   }
-  case HASH("TextProperty"): {
-    type = { PropertyType::TextProperty, "struct FText" };
+  case PropertyType::TextProperty: {
+    static const auto ref = TypeTable::Basic("FText", TypeKeyword::Struct);
+    type = { PropertyType::TextProperty, ref };
     break;
   }
-  case HASH("MulticastSparseDelegateProperty"): {
-    type = { PropertyType::MulticastSparseDelegateProperty, "struct FMulticastSparseDelegate" };
+  case PropertyType::MulticastSparseDelegateProperty: {
+    static const auto ref = TypeTable::Basic("FMulticastSparseDelegate", TypeKeyword::Struct);
+    type = { PropertyType::MulticastSparseDelegateProperty, ref };
     break;
   }
-  case HASH("EnumProperty"): {
+  case PropertyType::EnumProperty: {
     auto obj = this->Cast<UE_FEnumProperty>();
-    type = { PropertyType::EnumProperty, obj.GetTypeStr() };
-    break;
-  }
-  case HASH("DoubleProperty"): {
-    type = { PropertyType::DoubleProperty, "double" };
+    type = { PropertyType::EnumProperty, obj.GetTypeRef() };
     break;
   }
-  case HASH("MulticastDelegateProperty"): {
-    type = { PropertyType::MulticastDelegateProperty, "FMulticastDelegate" };
+  case PropertyType::DoubleProperty: {
+    static const auto ref = TypeTable::Basic("double");
+    type = { PropertyType::DoubleProperty, ref };
     break;
   }
-  case HASH("ClassProperty"): {
-    auto obj = this->Cast<UE_FClassProperty>();
-    type = { PropertyType::ClassProperty, obj.GetTypeStr() };
+  case PropertyType::MulticastDelegateProperty: {
+    static const auto ref = TypeTable::Basic("FMulticastDelegate");
+    type = { PropertyType::MulticastDelegateProperty, ref };
     break;
   }
-  case HASH("MulticastInlineDelegateProperty"): {
-    type = { PropertyType::MulticastDelegateProperty, "struct FMulticastInlineDelegate" };
+  case PropertyType::MulticastInlineDelegateProperty: {
+    static const auto ref = TypeTable::Basic("FMulticastInlineDelegate", TypeKeyword::Struct);
+    type = { PropertyType::MulticastDelegateProperty, ref };
     break;
   }
-  case HASH("MapProperty"): {
+  case PropertyType::MapProperty: {
     auto obj = this->Cast<UE_FMapProperty>();
-    type = { PropertyType::MapProperty, obj.GetTypeStr() };
-    break;
-  }
-  case HASH("InterfaceProperty"): {
-    auto obj = this->Cast<UE_FInterfaceProperty>();
-    type = { PropertyType::InterfaceProperty, obj.GetTypeStr() };
-    break;
-  }
-  case HASH("FieldPathProperty"): {
-    auto obj = this->Cast<UE_FFieldPathProperty>();
-    type = { PropertyType::FieldPathProperty, obj.GetTypeStr() };
+    type = { PropertyType::MapProperty, obj.GetTypeRef() };
     break;
   }
-  case HASH("SoftClassProperty"): {
-    type = { PropertyType::SoftClassProperty, "struct TSoftClassPtr<UObject>" };
+  default: {
+    type.second = TypeTable::Basic(objectClass.GetName());
     break;
   }
   }
@@ -957,75 +1114,67 @@ type UE_FProperty::GetType() const {
   return type;
 }
 
-IFProperty UE_FProperty::GetInterface() const { return IFProperty(this); }
-
 UE_UStruct UE_FStructProperty::GetStruct() const {
   return Read<UE_UStruct>(object + offsets.FProperty.Size);
 }
 
-std::string UE_FStructProperty::GetTypeStr() const {
-  return "struct " + GetStruct().GetCppName();
+TypeRef UE_FStructProperty::GetTypeRef() const {
+  auto s = GetStruct();
+  return TypeTable::Struct(ObjTable.IndexOf(s), s.GetCppName());
 }
 
 UE_UClass UE_FObjectPropertyBase::GetPropertyClass() const {
   return Read<UE_UClass>(object + offsets.FProperty.Size);
 }
 
-std::string UE_FObjectPropertyBase::GetTypeStr() const {
-  return "struct " + GetPropertyClass().GetCppName() + "*";
-}
-
 UE_FProperty UE_FArrayProperty::GetInner() const {
   return Read<UE_FProperty>(object + offsets.FProperty.Size);
 }
 
-std::string UE_FArrayProperty::GetTypeStr() const {
-  return "struct TArray<" + GetInner().GetType().second + ">";
+TypeRef UE_FArrayProperty::GetTypeRef() const {
+  return TypeTable::Template("TArray", { GetInner().GetType().second });
 }
 
 UE_UEnum UE_FByteProperty::GetEnum() const {
   return Read<UE_UEnum>(object + offsets.FProperty.Size);
 }
 
-std::string UE_FByteProperty::GetTypeStr() const {
+TypeRef UE_FByteProperty::GetTypeRef() const {
   auto e = GetEnum();
-  if (e) return "enum class " + e.GetName();
-  return "char";
+  if (e) return TypeTable::Enum(ObjTable.IndexOf(e), e.GetName());
+  return TypeTable::Basic("char");
 }
 
 uint8 UE_FBoolProperty::GetFieldMask() const {
   return Read<uint8>(object + offsets.FProperty.Size + 3);
 }
 
-std::string UE_FBoolProperty::GetTypeStr() const {
+TypeRef UE_FBoolProperty::GetTypeRef() const {
   if (GetFieldMask() == 0xFF) {
-    return "bool";
+    return TypeTable::Basic("bool");
   };
-  return "char";
+  return TypeTable::Basic("char");
 }
 
 UE_UClass UE_FEnumProperty::GetEnum() const {
   return Read<UE_UClass>(object + offsets.FProperty.Size + 8);
 }
 
-std::string UE_FEnumProperty::GetTypeStr() const {
-  return "enum class " + GetEnum().GetName();
+TypeRef UE_FEnumProperty::GetTypeRef() const {
+  auto e = GetEnum();
+  return TypeTable::Enum(ObjTable.IndexOf(e), e.GetName());
 }
 
 UE_UClass UE_FClassProperty::GetMetaClass() const {
-  return Read<UE_UClass>(object + offsets.FProperty.Size);
-}
-
-std::string UE_FClassProperty::GetTypeStr() const {
-  return "struct " + GetMetaClass().GetCppName() + "*";
+  return Read<UE_UClass>(object + offsets.FProperty.Size + 8);
 }
 
 UE_FProperty UE_FSetProperty::GetElementProp() const {
   return Read<UE_FProperty>(object + offsets.FProperty.Size);
 }
 
-std::string UE_FSetProperty::GetTypeStr() const {
-  return "struct TSet<" + GetElementProp().GetType().second + ">";
+TypeRef UE_FSetProperty::GetTypeRef() const {
+  return TypeTable::Template("TSet", { GetElementProp().GetType().second });
 }
 
 UE_FProperty UE_FMapProperty::GetKeyProp() const {
@@ -1036,30 +1185,22 @@ UE_FProperty UE_FMapProperty::GetValueProp() const {
   return Read<UE_FProperty>(object + offsets.FProperty.Size + 8);
 }
 
-std::string UE_FMapProperty::GetTypeStr() const {
-  return fmt::format("struct TMap<{}, {}>", GetKeyProp().GetType().second, GetValueProp().GetType().second);
+TypeRef UE_FMapProperty::GetTypeRef() const {
+  return TypeTable::Template("TMap", { GetKeyProp().GetType().second, GetValueProp().GetType().second });
 }
 
 UE_UClass UE_FInterfaceProperty::GetInterfaceClass() const {
   return Read<UE_UClass>(object + offsets.FProperty.Size);
 }
 
-std::string UE_FInterfaceProperty::GetTypeStr() const {
-  return "struct TScriptInterface<I" + GetInterfaceClass().GetName() + ">";
-}
-
 UE_FName UE_FFieldPathProperty::GetPropertyName() const {
   return Read<UE_FName>(object + offsets.FProperty.Size);
 }
 
-std::string UE_FFieldPathProperty::GetTypeStr() const {
-  return "struct TFieldPath<F" + GetPropertyName().GetName() + ">";
-}
-
 void UE_UPackage::GenerateBitPadding(std::vector<Member>& members, uint32 offset, uint8 bitOffset, uint8 size) {
   Member padding;
-  padding.Type = "char";
-  padding.Name = fmt::format("pad_{:0X}_{} : {}", offset, bitOffset, size);
+  padding.Type = TypeTable::Basic("char");
+  padding.Name = StringPool::Intern(fmt::format("pad_{:0X}_{} : {}", offset, bitOffset, size));
   padding.Offset = offset;
   padding.Size = 1;
   members.push_back(padding);
@@ -1067,8 +1208,8 @@ void UE_UPackage::GenerateBitPadding(std::vector<Member>& members, uint32 offset
 
 void UE_UPackage::GeneratePadding(std::vector<Member>& members, uint32 offset, uint32 size) {
   Member padding;
-  padding.Type = "char";
-  padding.Name = fmt::format("pad_{:0X}[{:#0x}]", offset, size);
+  padding.Type = TypeTable::Basic("char");
+  padding.Name = StringPool::Intern(fmt::format("pad_{:0X}[{:#0x}]", offset, size));
   padding.Offset = offset;
   padding.Size = size;
   members.push_back(padding);
@@ -1130,7 +1271,7 @@ void UE_UPackage::FillPadding(UE_UStruct object, std::vector<Member>& members, u
 
     };
 
-    ObjObjects.ForEachObjectOfClass((UE_UClass)object, callback);
+    ObjObjects.ForEachObjectOfClass((UE_UClass)object, callback, EIF_Unreachable | EIF_PendingKill);
 
     auto start = offset;
     for (uint32 i = 0; i < num; i++) {
@@ -1150,12 +1291,13 @@ void UE_UPackage::FillPadding(UE_UStruct object, std::vector<Member>& members, u
         m.Size = 8;
 
         if (ptrObject.IsA<UE_UObject>()) {
-          m.Type = "struct " + ptrObject.GetClass().GetCppName() + "*";
-          m.Name = ptrObject.GetName();
+          auto cls = ptrObject.GetClass();
+          m.Type = TypeTable::Struct(ObjTable.IndexOf(cls), cls.GetCppName(), TypeKeyword::Struct, 1);
+          m.Name = StringPool::Intern(ptrObject.GetName());
         }
         else {
-          m.Type = "void*";
-          m.Name = fmt::format("ptr_{:x}", ptr);
+          m.Type = TypeTable::Basic("void", TypeKeyword::None, 1);
+          m.Name = StringPool::Intern(fmt::format("ptr_{:x}", ptr));
         }
 
 
@@ -1177,7 +1319,7 @@ void UE_UPackage::FillPadding(UE_UStruct object, std::vector<Member>& members, u
 
 void UE_UPackage::GenerateFunction(UE_UFunction fn, Function *out, std::unordered_map<std::string, int>& memberMap) {
   out->FullName = ProcessUTF8Char(fn.GetFullName());
-  out->Flags = fn.GetFunctionFlags();
+  out->Flags = StringPool::Intern(fn.GetFunctionFlags());
   out->FuncFlag = fn.GetFunctionFlagInt();
   out->Func = fn.GetFunc();
   out->FuncName = fn.GetName();
@@ -1189,75 +1331,64 @@ void UE_UPackage::GenerateFunction(UE_UFunction fn, Function *out, std::unordere
     out->FuncName = "STATIC_" + out->FuncName;
   }
 
+  out->RetType = TypeTable::Void;
+
   std::unordered_map<std::string, int> paramCntMp;
-  auto generateParam = [&](IProperty *prop) {
-    
-    auto param_offset = prop->GetOffset();
-    auto param_size = prop->GetSize();
-    auto flags = prop->GetPropertyFlags();
+  for (auto& prop : PropertyChain::Get(fn).Properties) {
+    ParamInfo param;
+    param.Offset = prop.Offset;
+    param.Size = prop.ElementSize;
+    param.flags = prop.PropertyFlags;
     // if property has 'ReturnParm' flag
-    if (flags & 0x400) {
-      ParamInfo retInfo;
-      out->RetType = prop->GetType().second;
-      retInfo.Name = "ReturnValue";
-      retInfo.Offset = param_offset;
-      retInfo.Size = param_size;
-      retInfo.Type = out->RetType;
-      retInfo.flags = flags;
-      out->paramInfo.push_back(retInfo);
-      out->CppName = prop->GetType().second + " " + out->FuncName;
+    if (param.flags & 0x400) {
+      param.Name = StringPool::Intern("ReturnValue");
+      param.Type = prop.Type.second;
+      param.isReturn = true;
+      out->RetType = param.Type;
+      out->paramInfo.push_back(param);
     }
     // if property has 'Parm' flag
-    else if (flags & 0x80) {
-      ParamInfo paramInfo;
-      out->ParamTypes.push_back(prop->GetType().second);
-      auto ParamName = GetValidClassName(prop->GetName());
-      if (paramCntMp.count(ParamName) > 0) {
-        ParamName += fmt::format("_{}", ++paramCntMp[ParamName]);
+    else if (param.flags & 0x80) {
+      auto type = prop.Type.second;
+      out->ParamTypes.push_back(type);
+      auto name = GetValidClassName(prop.Name);
+      if (paramCntMp.count(name) > 0) {
+        name += fmt::format("_{}", ++paramCntMp[name]);
       }
       else {
-        paramCntMp[ParamName] = 1;
+        paramCntMp[name] = 1;
       }
-      if (ParamName[0] >= '0' && ParamName[0] <= '9') {
-        ParamName = "_" + ParamName;
+      if (name[0] >= '0' && name[0] <= '9') {
+        name = "_" + name;
       }
-      paramInfo.Offset = param_offset;
-      paramInfo.Size = param_size;
-      paramInfo.flags = flags;
-      paramInfo.Name = ParamName;
-      if (prop->GetArrayDim() > 1) {
-        out->Params += fmt::format("{}* {}, ", prop->GetType().second, ParamName);
-        paramInfo.Type = fmt::format("{}*", prop->GetType().second);
+      param.Name = StringPool::Intern(name);
+      if (prop.ArrayDim > 1) {
+        param.Type = TypeTable::PointerTo(type);
       } else {
-        if (flags & 0x100) {
-          out->Params += fmt::format("{}& {}, ", prop->GetType().second, ParamName);
-          paramInfo.Type = fmt::format("{}&", prop->GetType().second);
-        }
-        else {
-          out->Params += fmt::format("{} {}, ", prop->GetType().second, ParamName);
-          paramInfo.Type = prop->GetType().second;
-        }
+        param.Type = type;
+        param.isOutRef = param.flags & 0x100;
       }
-      out->paramInfo.push_back(paramInfo);
+      out->paramInfo.push_back(param);
     }
-  };
-
-  for (auto prop = fn.GetChildProperties().Cast<UE_FProperty>(); prop; prop = prop.GetNext().Cast<UE_FProperty>()) {
-    auto propInterface = prop.GetInterface();
-    generateParam(&propInterface);
-  }
-  for (auto prop = fn.GetChildren().Cast<UE_UProperty>(); prop; prop = prop.GetNext().Cast<UE_UProperty>()) {
-    auto propInterface = prop.GetInterface();
-    generateParam(&propInterface);
-  }
-  if (out->Params.size()) {
-    out->Params.erase(out->Params.size() - 2);
   }
+}
 
-  if (out->CppName.size() == 0) {
-    out->RetType = "void";
-    out->CppName = "void " + out->FuncName;
+std::string UE_UPackage::Function::GetCppName() const {
+  return std::string(StringPool::Get(declareStatic)) + TypeTable::Render(RetType) + " " + FuncName;
+}
+
+std::string UE_UPackage::Function::GetParams() const {
+  std::string params;
+  for (auto& param : paramInfo) {
+    if (param.isReturn) continue;
+    if (params.size()) params += ", ";
+    params += TypeTable::Render(param.Type);
+    if (param.isOutRef) params += '&';
+    params += ' ';
+    params += StringPool::Get(param.Name);
   }
+  if (badDeclareFunc) return "/*" + params + "*/";
+  return params;
 }
 
 std::string to_hex_string(int value) {
@@ -1327,14 +1458,13 @@ std::string UE_UPackage::GetValidClassName(std::string str) {
   return str;
 }
 
-// To solve the redefine of the same class name
-std::unordered_map<std::string, int> typeDefCnt;
-
-void UE_UPackage::GenerateStruct(UE_UStruct object, std::vector<Struct>& arr, bool findPointers) {
+void UE_UPackage::GenerateStruct(UE_UStruct object, const std::string& className, std::vector<Struct>& arr, bool findPointers) {
   Struct s;
+  s.Index = ObjTable.IndexOf(object);
   //s.Size = object.GetSize();
-  if(ClassSizeFixer::sizeMp.count(object.GetAddress()))
-    s.Size = ClassSizeFixer::sizeMp[object.GetAddress()]; // Fix the class
+  auto fixedSize = ClassSizeFixer::GetSize(s.Index);
+  if (fixedSize != -1)
+    s.Size = fixedSize; // Fix the class
   else
     s.Size = object.GetSize();
   if (s.Size == 0) {
@@ -1343,25 +1473,19 @@ void UE_UPackage::GenerateStruct(UE_UStruct object, std::vector<Struct>& arr, bo
   s.Inherited = 0;
 
   s.FullName = ProcessUTF8Char(object.GetFullName());
-  s.ClassName = object.GetCppName();
+  s.ClassName = className;
 
   if (s.ClassName == "UWorld") {
     // Gworld ̬Ա
     Member static_gworld;
-    static_gworld.Type = "static class UWorld**";
+    static_gworld.isStatic = true;
+    static_gworld.Type = TypeTable::Struct(ObjTable.IndexOf(object), "UWorld", TypeKeyword::Class, 2);
     static_gworld.Offset = 0;
-    static_gworld.Name = "GWorld";
+    static_gworld.Name = StringPool::Intern("GWorld");
     static_gworld.Size = 8;
     s.Members.push_back(static_gworld);
   }
 
-  if (typeDefCnt.count(s.ClassName)) {
-    s.ClassName += fmt::format("_def{}", ++typeDefCnt[s.ClassName]);
-  }
-  else {
-    typeDefCnt[s.ClassName] = 1;
-  }
-
   if (object.IsA<UE_UClass>()) {
     s.CppName = "class " + GetValidClassName(s.ClassName);
   }
@@ -1369,14 +1493,17 @@ void UE_UPackage::GenerateStruct(UE_UStruct object, std::vector<Struct>& arr, bo
     s.CppName = "struct " + GetValidClassName(s.ClassName);
   }
   
-  s.SuperName = GetValidClassName(object.GetSuper().GetCppName());
+  auto superName = GetValidClassName(object.GetSuper().GetCppName());
+  s.SuperName = StringPool::Intern(superName);
 
   auto super = object.GetSuper();
   
   if (super) {
-    s.CppName += " : public " + s.SuperName;
+    s.SuperIndex = ObjTable.IndexOf(super);
+    s.CppName += " : public " + superName;
     //s.Inherited = super.GetSize();
-    s.Inherited = ClassSizeFixer::sizeMp[super.GetAddress()];
+    auto superSize = ClassSizeFixer::GetSize(ObjTable.IndexOf(super));
+    s.Inherited = superSize != -1 ? superSize : 0;
   }
 
   uint32 offset = s.Inherited;
@@ -1385,48 +1512,48 @@ void UE_UPackage::GenerateStruct(UE_UStruct object, std::vector<Struct>& arr, bo
   std::unordered_map<std::string, int> memberNameCntMp;
   std::unordered_map<std::string, int> functionNameCntMp;
 
-  auto generateMember = [&](IProperty *prop, Member *m) {
-    auto arrDim = prop->GetArrayDim();
-    m->Size = prop->GetSize() * arrDim;
+  auto generateMember = [&](const PropertyRecord& prop, Member *m) {
+    auto arrDim = prop.ArrayDim;
+    m->Size = prop.ElementSize * arrDim;
     m->isSuspectMember = false;
     if (m->Size == 0) {
       return;
     } // this shouldn't be zero
 
-    auto type = prop->GetType();
+    auto& type = prop.Type;
     m->Type = type.second;
     
-    m->Name = prop->GetName();
+    std::string name = prop.Name;
 
-    FixKeywordConflict(m->Name);
-    m->Name = GetValidClassName(m->Name);
-    m->Offset = prop->GetOffset();
+    FixKeywordConflict(name);
+    name = GetValidClassName(name);
+    m->Offset = prop.Offset;
 
-    if (m->Name[0] >= '0' && m->Name[0] <= '9') {
-      m->Name = "_" + m->Name;
+    if (name[0] >= '0' && name[0] <= '9') {
+      name = "_" + name;
     }
 
-    if (memberNameCntMp.count(m->Name) > 0) {
-      memberNameCntMp[m->Name]++;
-      m->Name += fmt::format("_{}", memberNameCntMp[m->Name]);
+    if (memberNameCntMp.count(name) > 0) {
+      memberNameCntMp[name]++;
+      name += fmt::format("_{}", memberNameCntMp[name]);
     }
     else {
-      memberNameCntMp[m->Name] = 1;
+      memberNameCntMp[name] = 1;
     }
     if (m->Offset < s.Inherited) {
       // Should be solved by ClassSizeFixer and this will not appear!
       // Impossible situation, but some game still fucking appear
       // mark the member to suspect member, and do not actually use it.
-      printf("[Warning] Bad member offset: [%s]->[%s] offset: %X \n", s.FullName.c_str(), m->Name.c_str(), m->Offset);
+      printf("[Warning] Bad member offset: [%s]->[%s] offset: %X \n", s.FullName.c_str(), name.c_str(), m->Offset);
       m->isSuspectMember = true;
+      m->Name = StringPool::Intern(name);
       return;
     }
     if (m->Offset > offset) {
       UE_UPackage::FillPadding(object, s.Members, offset, bitOffset, m->Offset, findPointers);
     }
-    if (type.first == PropertyType::BoolProperty && *(uint32*)type.second.data() != 'loob') {
-      auto boolProp = prop;
-      auto mask = boolProp->GetFieldMask();
+    if (type.first == PropertyType::BoolProperty && TypeTable::Get(type.second).Name != "bool") {
+      auto mask = prop.FieldMask;
       uint8 zeros = 0, ones = 0;
       while (mask & ~1) {
         mask >>= 1;
@@ -1440,7 +1567,7 @@ void UE_UPackage::GenerateStruct(UE_UStruct object, std::vector<Struct>& arr, bo
         UE_UPackage::GenerateBitPadding(s.Members, offset, bitOffset, zeros - bitOffset);
         bitOffset = zeros;
       }
-      m->Name += fmt::format(" : {}", ones);
+      name += fmt::format(" : {}", ones);
       bitOffset += ones;
 
       if (bitOffset == 8) {
@@ -1450,60 +1577,54 @@ void UE_UPackage::GenerateStruct(UE_UStruct object, std::vector<Struct>& arr, bo
 
     } else {
       if (arrDim > 1) {
-        m->Name += fmt::format("[{:#0x}]", arrDim);
+        name += fmt::format("[{:#0x}]", arrDim);
       }
 
       offset += m->Size;
     }
+    m->Name = StringPool::Intern(name);
   };
 
-  for (auto prop = object.GetChildProperties().Cast<UE_FProperty>(); prop; prop = prop.GetNext().Cast<UE_FProperty>()) {
+  auto& chain = PropertyChain::Get(object);
+  for (auto& prop : chain.Properties) {
     Member m;
-    auto propInterface = prop.GetInterface();
-    generateMember(&propInterface, &m);
+    generateMember(prop, &m);
     s.Members.push_back(m);
   }
 
-  for (auto child = object.GetChildren(); child; child = child.GetNext()) {
-    if (child.IsA<UE_UProperty>()) {
-      auto prop = child.Cast<UE_UProperty>();
-      Member m;
-      auto propInterface = prop.GetInterface();
-      generateMember(&propInterface, &m);
-      s.Members.push_back(m);
-    }
-  }
-
-  for (auto child = object.GetChildren(); child; child = child.GetNext()) {
-    if (child.IsA<UE_UFunction>()) {
-      auto fn = child.Cast<UE_UFunction>();
-      Function f;
-      GenerateFunction(fn, &f, memberNameCntMp);
-      // to avoid the repeat function name ...
-      if (functionNameCntMp.count(f.FullName) == 0) {
-        functionNameCntMp[f.FullName] = 1;
-        s.Functions.push_back(f);
-      }
+  for (auto fn : chain.Functions) {
+    Function f;
+    GenerateFunction(fn, &f, memberNameCntMp);
+    // to avoid the repeat function name ...
+    if (functionNameCntMp.count(f.FullName) == 0) {
+      functionNameCntMp[f.FullName] = 1;
+      s.Functions.push_back(std::move(f));
     }
   }
+  // the chains of the struct and its functions are not read again
+  PropertyChain::Release(object);
   // USkeletalMeshComponentעGetBoneWorldPos
   if (s.ClassName == "USkeletalMeshComponent") {
     Function GetBoneWorldPos_fn;
-    GetBoneWorldPos_fn.CppName = "FVector GetBoneWorldPos";
+    ParamInfo boneId;
+    boneId.Name = StringPool::Intern("boneId");
+    boneId.Type = TypeTable::Basic("const int32_t");
+    boneId.isOutRef = true;
+    boneId.flags = 0x80;
+    GetBoneWorldPos_fn.paramInfo.push_back(boneId);
     GetBoneWorldPos_fn.FuncName = "GetBoneWorldPos";
-    GetBoneWorldPos_fn.Params = "const int32_t& boneId";
-    GetBoneWorldPos_fn.RetType = "FVector";
+    GetBoneWorldPos_fn.RetType = TypeTable::Basic("FVector");
     GetBoneWorldPos_fn.FullName = "Dumper_Generated_Function";
     GetBoneWorldPos_fn.Func = Base;
-    GetBoneWorldPos_fn.declareConst = " const";
+    GetBoneWorldPos_fn.declareConst = StringPool::Intern(" const");
     s.Functions.push_back(GetBoneWorldPos_fn);
   }
   // StaticClass
   {
     Function static_class_fn;
-    static_class_fn.CppName = "static UClass* StaticClass";
+    static_class_fn.declareStatic = StringPool::Intern("static ");
     static_class_fn.FuncName = "StaticClass";
-    static_class_fn.RetType = "UClass*";
+    static_class_fn.RetType = TypeTable::Basic("UClass", TypeKeyword::None, 1);
     static_class_fn.FullName = "Dumper_Generated_Function";
     static_class_fn.Func = Base;
     s.Functions.push_back(static_class_fn);
@@ -1513,7 +1634,7 @@ void UE_UPackage::GenerateStruct(UE_UStruct object, std::vector<Struct>& arr, bo
     UE_UPackage::FillPadding(object, s.Members, offset, bitOffset, s.Size, findPointers);
   }
 
-  arr.push_back(s);
+  arr.push_back(std::move(s));
 }
 
 void UE_UPackage::FixKeywordConflict(std::string& tocheck) {
@@ -1628,166 +1749,300 @@ void UE_UPackage::FixKeywordConflict(std::string& tocheck) {
 
 void UE_UPackage::GenerateEnum(UE_UEnum object, std::vector<Enum> &arr) {
   Enum e;
+  e.Index = ObjTable.IndexOf(object);
   e.FullName = ProcessUTF8Char(object.GetFullName());
  
   auto names = object.GetNames();
   
-  uint64 max = 0;
+  int64 min = 0, max = 0;
   uint64 nameSize = ((offsets.FName.Number + 4) + 7) & ~(7);
   uint64 pairSize = nameSize + 8;
 
+  // a broken TArray header must not turn into a huge allocation, no enum has that many names
+  if (names.Count > 0x10000) names.Count = 0;
+
+  // TArray<TPair<FName, int64>> in one read
+  std::vector<uint8> pairs(names.Count * pairSize);
+  if (names.Count && !Read(names.Data, pairs.data(), pairs.size())) names.Count = 0;
+
   for (uint32 i = 0; i < names.Count; i++) {
 
-    auto pair = names.Data + i * pairSize;
-    auto name = UE_FName(pair);
-    auto str = name.GetName();
+    auto pair = pairs.data() + i * pairSize;
+    auto str = UE_FName::GetName(*(uint32*)pair, *(uint32*)(pair + offsets.FName.Number));
     auto pos = str.find_last_of(':');
     if (pos != std::string::npos) {
       str = str.substr(pos + 1);
     }
 
-    //auto value = Read<int64>(pair + nameSize);
-    // this read some wrong value, so I force it to be ordered... May be wrong?
-    auto value = i;
+    auto value = *(int64*)(pair + nameSize);
 
-    if ((uint64)value > max) max = value;
+    if (value > max) max = value;
+    if (value < min) min = value;
 
     UE_UPackage::FixKeywordConflict(str);
 
     str.append(" = ").append(fmt::format("{}", value));
     e.Members.push_back(str);
   }
+  // the names could not be read, an enum without members is not emitted
+  if (e.Members.empty()) return;
 
   const char* type = nullptr;
 
-  // I didn't see int16 yet, so I assume the engine generates only int32 and uint8:
-  if (max > 256) {
-    type = " : int32_t"; // I assume if enum has a negative value it is int32
+  // I didn't see int16 yet, so the smallest of uint8, int32 and int64 holding every value is used:
+  if (min >= 0 && max <= 0xFF) {
+    type = " : uint8_t";
+  }
+  else if (min >= INT32_MIN && max <= INT32_MAX) {
+    type = " : int32_t";
   }
   else {
-    type = " : uint8_t";
+    type = " : int64_t";
   }
 
   e.EnumName = object.GetName();
   e.CppName = "enum class " + object.GetName() + type;
 
-  if (e.Members.size()) {
-    arr.push_back(e);
-  }
+  arr.push_back(std::move(e));
 }
 
-void UE_UPackage::SaveStruct(std::vector<Struct> &arr, FILE *file) {
+void UE_UPackage::SaveStruct(std::vector<Struct> &arr, fmt::memory_buffer& file) {
   for (auto &s : arr) {
-    fmt::print(file, "// {}\n// Size: {:#04x} (Inherited: {:#04x})\n{} {{\npublic:\n",  s.FullName, s.Size, s.Inherited, s.CppName);
+    fmt::format_to(std::back_inserter(file), "// {}\n// Size: {:#04x} (Inherited: {:#04x})\n{} {{\npublic:\n",  s.FullName, s.Size, s.Inherited, s.CppName);
     for (auto &m : s.Members) {
       if (m.isSuspectMember) {
-        fmt::print(file, "\n\t// {} {}; // Bad member offset! {:#04x}({:#04x})", m.Type, m.Name, m.Offset, m.Size);
+        fmt::format_to(std::back_inserter(file), "\n\t// {} {}; // Bad member offset! {:#04x}({:#04x})", m.GetType(), StringPool::Get(m.Name), m.Offset, m.Size);
       }
       else {
-        fmt::print(file, "\n\t{} {}; // {:#04x}({:#04x})", m.Type, m.Name, m.Offset, m.Size);
+        fmt::format_to(std::back_inserter(file), "\n\t{} {}; // {:#04x}({:#04x})", m.GetType(), StringPool::Get(m.Name), m.Offset, m.Size);
       }
     }
     if (s.Functions.size()) {
-      fwrite("\n", 1, 1, file);
+      file.push_back('\n');
       for (auto &f : s.Functions) {
-        fmt::print(file, "\n\t{}({}){}; // {} // ({}) // @ game+{:#08x}", f.CppName, f.Params, f.declareConst, f.FullName, f.Flags, f.Func - Base);
+        fmt::format_to(std::back_inserter(file), "\n\t{}({}){}; // {} // ({}) // @ game+{:#08x}", f.GetCppName(), f.GetParams(), StringPool::Get(f.declareConst), f.FullName, StringPool::Get(f.Flags), f.Func - Base);
       }
     }
-    fmt::print(file, "\n}};\n\n");
+    fmt::format_to(std::back_inserter(file), "\n}};\n\n");
   }
 }
 
-void UE_UPackage::SaveStructSpacing(std::vector<Struct> &arr, FILE *file) {
+void UE_UPackage::SaveStructSpacing(std::vector<Struct> &arr, fmt::memory_buffer& file) {
   for (auto &s : arr) {
-    fmt::print(file, "// {}\n// Size: {:#04x} (Inherited: {:#04x})\n{} {{\npublic:\n", s.FullName, s.Size, s.Inherited, s.CppName);
+    fmt::format_to(std::back_inserter(file), "// {}\n// Size: {:#04x} (Inherited: {:#04x})\n{} {{\npublic:\n", s.FullName, s.Size, s.Inherited, s.CppName);
     for (auto &m : s.Members) {
       if (m.isSuspectMember) {
-        fmt::print(file, "\n\t// {:69} {:60} //  Bad member offset! {:#04x}({:#04x})", m.Type, m.Name + ";", m.Offset, m.Size);
+        fmt::format_to(std::back_inserter(file), "\n\t// {:69} {:60} //  Bad member offset! {:#04x}({:#04x})", m.GetType(), fmt::format("{};", StringPool::Get(m.Name)), m.Offset, m.Size);
       }
       else {
-        fmt::print(file, "\n\t{:69} {:60} // {:#04x}({:#04x})", m.Type, m.Name + ";", m.Offset, m.Size);
+        fmt::format_to(std::back_inserter(file), "\n\t{:69} {:60} // {:#04x}({:#04x})", m.GetType(), fmt::format("{};", StringPool::Get(m.Name)), m.Offset, m.Size);
       }
     }
     if (s.Functions.size()) {
-      fwrite("\n", 1, 1, file);
+      file.push_back('\n');
       for (auto &f : s.Functions) {
-        fmt::print(file, "\n\t{:130} // {} // ({}) // @ game+{:#08x}", fmt::format("{}({}){};", f.CppName, f.Params, f.declareConst), f.FullName, f.Flags, f.Func - Base);
+        fmt::format_to(std::back_inserter(file), "\n\t{:130} // {} // ({}) // @ game+{:#08x}", fmt::format("{}({}){};", f.GetCppName(), f.GetParams(), StringPool::Get(f.declareConst)), f.FullName, StringPool::Get(f.Flags), f.Func - Base);
       }
     }
 
-    fmt::print(file, "\n}};\n\n");
+    fmt::format_to(std::back_inserter(file), "\n}};\n\n");
   }
 }
 
-void UE_UPackage::SaveEnum(std::vector<Enum> &arr, FILE *file) {
+void UE_UPackage::SaveEnum(std::vector<Enum> &arr, fmt::memory_buffer& file) {
   for (auto &e : arr) {
-    fmt::print(file, "// {}\n{} {{", e.FullName, e.CppName);
+    if (e.Members.empty()) continue;
+    fmt::format_to(std::back_inserter(file), "// {}\n{} {{", e.FullName, e.CppName);
 
     auto lastIdx = e.Members.size() - 1;
     for (auto i = 0; i < lastIdx; i++) {
       auto& m = e.Members.at(i);
-      fmt::print(file, "\n\t{},", m);
+      fmt::format_to(std::back_inserter(file), "\n\t{},", m);
     }
 
     auto& m = e.Members.at(lastIdx);
-    fmt::print(file, "\n\t{}", m);
+    fmt::format_to(std::back_inserter(file), "\n\t{}", m);
+
+    fmt::format_to(std::back_inserter(file), "\n}};\n\n");
+  }
+}
+
+void UE_UPackage::DeclareTypes(std::vector<UE_UPackage>& packages) {
+  auto classClass = ObjTable.IndexOf(UE_UClass::StaticClass());
+  auto scriptStructClass = ObjTable.IndexOf(UE_UScriptStruct::StaticClass());
+  auto enumClass = ObjTable.IndexOf(UE_UEnum::StaticClass());
+  // To solve the redefine of the same class name
+  std::unordered_map<std::string, int> typeDefCnt;
+  for (auto& package : packages) {
+    package.Declarations.clear();
+    for (auto& object : package.Package->second) {
+      Declaration decl;
+      decl.Index = ObjTable.IndexOf(object);
+      if (ObjTable.IsA(decl.Index, classClass) || ObjTable.IsA(decl.Index, scriptStructClass)) {
+        decl.Kind = ObjTable.IsA(decl.Index, classClass) ? DeclKind::Class : DeclKind::Structure;
+        decl.Name = ObjTable.GetCppName(decl.Index);
+        decl.DeclareOnly = DumpScope::IsDeclared(decl.Index);
+        if (typeDefCnt.count(decl.Name)) {
+          decl.Name += fmt::format("_def{}", ++typeDefCnt[decl.Name]);
+        }
+        else {
+          typeDefCnt[decl.Name] = 1;
+        }
+      } else if (ObjTable.IsA(decl.Index, enumClass)) {
+        // enums without any name are left out
+        if (!object.Cast<UE_UEnum>().GetNames().Count) continue;
+        decl.Kind = DeclKind::Enum;
+        decl.Name = ObjTable.GetName(decl.Index);
+      } else {
+        continue;
+      }
+      package.Declarations.push_back(decl);
+    }
+  }
+}
 
-    fmt::print(file, "\n}};\n\n");
+void UE_UPackage::Process(std::vector<UE_UPackage>& packages, const std::function<void(UE_UPackage&)>& onPackage) {
+  // Packages are generated in windows of at least this many types, the finished
+  // packages of a window are handed on while the next one is generated
+  constexpr size_t WindowSize = 2048;
+
+  struct Task {
+    UE_UPackage* Package;
+    const Declaration* Decl;
+    std::vector<Struct> Structs; // GenerateStruct/GenerateEnum append one result
+    std::vector<Enum> Enums;
+  };
+
+  size_t total = 0;
+  for (auto& package : packages) {
+    for (auto& decl : package.Declarations) total += !decl.DeclareOnly;
+  }
+
+  std::mutex printLock;
+  size_t done = 0;
+  std::vector<Task> tasks;
+  size_t first = 0;
+  for (size_t i = 0; i < packages.size(); i++) {
+    for (auto& decl : packages[i].Declarations) {
+      if (!decl.DeclareOnly) tasks.push_back({ &packages[i], &decl });
+    }
+    if (tasks.size() < WindowSize && i + 1 < packages.size()) continue;
+
+    // one task per type, so a package with most of the classes is spread over every worker
+    TaskPool::GetInstance()->ParallelFor((uint32)tasks.size(), [&](uint32 id) {
+      auto& task = tasks[id];
+      auto object = ObjTable.Address[task.Decl->Index];
+      switch (task.Decl->Kind) {
+      case DeclKind::Class: GenerateStruct(object, task.Decl->Name, task.Structs, task.Package->FindPointers); break;
+      case DeclKind::Structure: GenerateStruct(object, task.Decl->Name, task.Structs, false); break;
+      case DeclKind::Enum: GenerateEnum(object, task.Enums); break;
+      }
+      std::lock_guard<std::mutex> guard(printLock);
+      if (++done % 256 == 0 || done == total) {
+        fmt::print("\rProcessing: {}/{}", done, total);
+      }
+    });
+
+    // tasks are in package and object order, appending them keeps the declaration order
+    for (auto& task : tasks) {
+      auto& package = *task.Package;
+      auto& arr = task.Decl->Kind == DeclKind::Class ? package.Classes : package.Structures;
+      for (auto& s : task.Structs) arr.push_back(std::move(s));
+      for (auto& e : task.Enums) package.Enums.push_back(std::move(e));
+    }
+    tasks.clear();
+    for (; first <= i; first++) {
+      onPackage(packages[first]);
+    }
   }
 }
 
-void UE_UPackage::Process() {
-  auto &objects = Package->second;
-  for (auto &object : objects) {
-    if (object.IsA<UE_UClass>()) {
-      GenerateStruct(object.Cast<UE_UStruct>(), Classes, FindPointers);
-    } else if (object.IsA<UE_UScriptStruct>()) {
-      GenerateStruct(object.Cast<UE_UStruct>(), Structures, false);
-    } else if (object.IsA<UE_UEnum>()) {
-      GenerateEnum(object.Cast<UE_UEnum>(), Enums);
+void UE_UPackage::ResolveParamStructNames(UE_UPackage& package, std::unordered_map<std::string, int>& paramStructNameMp) {
+  auto resolve = [&](Function& func) {
+    if (func.FullName == "Dumper_Generated_Function") return;
+    func.GeneratedParamName = GetValidClassName(func.FullName);
+    if (paramStructNameMp.count(func.GeneratedParamName)) {
+      func.GeneratedParamName = func.GeneratedParamName + fmt::format("_Param_{}", ++paramStructNameMp[func.GeneratedParamName]);
     }
+    else {
+      paramStructNameMp[func.GeneratedParamName] = 1;
+      func.GeneratedParamName = func.GeneratedParamName + "_Param";
+    }
+  };
+
+  // same order SavePackageCpp writes the param structs in
+  for (auto& stru : package.Structures) {
+    for (auto& func : stru.Functions) resolve(func);
+  }
+  for (auto& stru : package.Classes) {
+    for (auto& func : stru.Functions) resolve(func);
   }
 }
 
-void UE_UPackage::AddAlignDef(FILE* file, int type) {
+void UE_UPackage::Release() {
+  std::vector<Struct>().swap(Classes);
+  std::vector<Struct>().swap(Structures);
+  std::vector<Enum>().swap(Enums);
+}
+
+void UE_UPackage::AddAlignDef(fmt::memory_buffer& file, int type) {
   if (type == 1) {
-    fmt::print(file, "\n#ifdef _MSC_VER\n\t#pragma pack(push, 0x01)\n#endif\n");
+    fmt::format_to(std::back_inserter(file), "\n#ifdef _MSC_VER\n\t#pragma pack(push, 0x01)\n#endif\n");
   }
   else if (type == 2) {
-    fmt::print(file, "\n#ifdef _MSC_VER\n\t#pragma pack(pop)\n#endif\n");
+    fmt::format_to(std::back_inserter(file), "\n#ifdef _MSC_VER\n\t#pragma pack(pop)\n#endif\n");
   }
 }
 
-void UE_UPackage::AddNamespaceDef(FILE* file, int type) {
+void UE_UPackage::AddNamespaceDef(fmt::memory_buffer& file, int type) {
 
   if (type == 1) {
-    fmt::print(file, "\nnamespace {} {{\n", GNameSpace);
+    fmt::format_to(std::back_inserter(file), "\nnamespace {} {{\n", GNameSpace);
   }
   else if (type == 2) {
-    fmt::print(file, "\n}}\n");
+    fmt::format_to(std::back_inserter(file), "\n}}\n");
   }
 }
 
-void UE_UPackage::SavePackageHeader(bool hasClassHeader, bool hasStructHeader, FILE* file) {
-  fmt::print(file, "#pragma once\n\n");
-  std::string packageName = this->packageName;
-  char chars[] = "/\\:*?\"<>|+";
-  for (auto c : chars) {
-    auto pos = packageName.find(c);
-    if (pos != std::string::npos) {
-      packageName[pos] = '_';
+bool UE_UPackage::SavePackageHeader(const fs::path& dir, const std::vector<std::string>& includes, const std::vector<std::string>& declares, FileWriter& writer) {
+  auto fileName = [](std::string packageName) {
+    char chars[] = "/\\:*?\"<>|+";
+    for (auto c : chars) {
+      auto pos = packageName.find(c);
+      if (pos != std::string::npos) {
+        packageName[pos] = '_';
+      }
     }
+    return packageName;
+  };
+  std::string packageName = fileName(this->packageName);
+
+  fmt::memory_buffer file;
+  fmt::format_to(std::back_inserter(file), "#pragma once\n\n");
+  for (auto& include : includes) {
+    fmt::format_to(std::back_inserter(file), "#include \"{}_package.h\"\n", fileName(include));
   }
-  if (hasStructHeader) {
-    fmt::print(file, "#include \"{}_struct.h\"\n", packageName);
+  if (includes.size()) {
+    file.push_back('\n');
+  }
+  if (declares.size()) {
+    fmt::format_to(std::back_inserter(file), "namespace {} {{\n", GNameSpace);
+    for (auto& declare : declares) {
+      fmt::format_to(std::back_inserter(file), "\t{};\n", declare);
+    }
+    fmt::format_to(std::back_inserter(file), "}}\n\n");
   }
-  if (hasClassHeader) {
-    fmt::print(file, "#include \"{}_classes.h\"\n", packageName);
+  if (HasStructHeader) {
+    fmt::format_to(std::back_inserter(file), "#include \"{}_struct.h\"\n", packageName);
   }
-  fmt::print(file, "#include \"{}_param.h\"\n", packageName);
+  if (HasClassHeader) {
+    fmt::format_to(std::back_inserter(file), "#include \"{}_classes.h\"\n", packageName);
+  }
+  fmt::format_to(std::back_inserter(file), "#include \"{}_param.h\"\n", packageName);
+  return writer.Write(dir / (packageName + "_package.h"), std::move(file));
 }
 
-void UE_UPackage::SavePackageCpp(FILE* cppFile, FILE* paramFile) {
+void UE_UPackage::SavePackageCpp(fmt::memory_buffer& cppFile, fmt::memory_buffer& paramFile) {
   struct ParamStruct {
     std::string paramName;
     std::string funcName;
@@ -1799,18 +2054,18 @@ void UE_UPackage::SavePackageCpp(FILE* cppFile, FILE* paramFile) {
   };
   std::string gameInfo = "/**\n * Name: VAR_GAME_NAME\n * Version : VAR_GAME_VERSION\n */ \n";
   EngineHeaderExport::ReplaceVAR(gameInfo);
-  fmt::print(cppFile, "{}", gameInfo);
-  fmt::print(paramFile, "{}", gameInfo);
-  fmt::print(paramFile, "#pragma once\n\n");
+  fmt::format_to(std::back_inserter(cppFile), "{}", gameInfo);
+  fmt::format_to(std::back_inserter(paramFile), "{}", gameInfo);
+  fmt::format_to(std::back_inserter(paramFile), "#pragma once\n\n");
   AddAlignDef(paramFile, 1);
-  fmt::print(paramFile, "\n\nnamespace {}\n{{\n", GNameSpace);
-  fmt::print(cppFile, "#include \"../SDK.h\"");
-  fmt::print(cppFile, "\n\nnamespace {}\n{{\n", GNameSpace);
-  auto GenerateFunctionHeader = [](FILE* file, FunctionHeader &header) {
-    fmt::print(file, "\t/**\n");
-    fmt::print(file, "\t * Function: \n");
-    fmt::print(file, "\t * \tRVA: {:#08X}\n", header.RVA);
-    fmt::print(file, "\t * \tName: {}\n", header.name);
+  fmt::format_to(std::back_inserter(paramFile), "\n\nnamespace {}\n{{\n", GNameSpace);
+  fmt::format_to(std::back_inserter(cppFile), "#include \"../SDK.h\"");
+  fmt::format_to(std::back_inserter(cppFile), "\n\nnamespace {}\n{{\n", GNameSpace);
+  auto GenerateFunctionHeader = [](fmt::memory_buffer& file, FunctionHeader &header) {
+    fmt::format_to(std::back_inserter(file), "\t/**\n");
+    fmt::format_to(std::back_inserter(file), "\t * Function: \n");
+    fmt::format_to(std::back_inserter(file), "\t * \tRVA: {:#08X}\n", header.RVA);
+    fmt::format_to(std::back_inserter(file), "\t * \tName: {}\n", header.name);
     std::string flags = "(";
     for (int i = 0; i < header.flags.size(); i++) {
       if (i != 0) {
@@ -1821,10 +2076,10 @@ void UE_UPackage::SavePackageCpp(FILE* cppFile, FILE* paramFile) {
       }
     }
     flags += ")";
-    fmt::print(file, "\t * \tFlags: {}\n", flags);
-    fmt::print(file, "\t */\n");
+    fmt::format_to(std::back_inserter(file), "\t * \tFlags: {}\n", flags);
+    fmt::format_to(std::back_inserter(file), "\t */\n");
   };
-  auto InjectGetBoneWorldPos = [](FILE* file, Struct& stru) {
+  auto InjectGetBoneWorldPos = [](fmt::memory_buffer& file, Struct& stru) {
     std::string codeTemplate;
     auto replaceSubstr = [](std::string& originalStr, std::string substring, std::string replacement) {
       size_t pos = 0;
@@ -1838,9 +2093,9 @@ void UE_UPackage::SavePackageCpp(FILE* cppFile, FILE* paramFile) {
     };
     if (!EngineHeaderExport::LoadResourceText(codeTemplate, INJECTED_GETBONEWORLDPOS)) return;
     replaceSubstr(codeTemplate, "\r\n", "\n");
-    fmt::print(file, "\n{}\n", codeTemplate);
+    fmt::format_to(std::back_inserter(file), "\n{}\n", codeTemplate);
   };
-  auto GenerateStaticClass = [&GenerateFunctionHeader, &InjectGetBoneWorldPos](FILE* file, Struct& stru) {
+  auto GenerateStaticClass = [&GenerateFunctionHeader, &InjectGetBoneWorldPos](fmt::memory_buffer& file, Struct& stru) {
     if (stru.ClassName == "USkinnedMeshComponent") {
       // inject GetBoneWorldPos function
       InjectGetBoneWorldPos(file, stru);
@@ -1851,52 +2106,38 @@ void UE_UPackage::SavePackageCpp(FILE* cppFile, FILE* paramFile) {
     header.flags.push_back("Predefined");
     header.flags.push_back("Static");
     GenerateFunctionHeader(file, header);
-    fmt::print(file, "\tUClass* {}::StaticClass()\n\t{{\n", GetValidClassName(stru.ClassName));
-    fmt::print(file, "\t\tstatic UClass* ptr = nullptr;\n");
-    fmt::print(file, "\t\tif (!ptr)\n");
-    fmt::print(file, "\t\t\tptr = UObject::FindClass(\"{}\");\n", GetCpp_xString(stru.FullName));
-    fmt::print(file, "\t\treturn ptr;\n");
-    fmt::print(file, "\t}}\n\n");
+    fmt::format_to(std::back_inserter(file), "\tUClass* {}::StaticClass()\n\t{{\n", GetValidClassName(stru.ClassName));
+    fmt::format_to(std::back_inserter(file), "\t\tstatic UClass* ptr = nullptr;\n");
+    fmt::format_to(std::back_inserter(file), "\t\tif (!ptr)\n");
+    fmt::format_to(std::back_inserter(file), "\t\t\tptr = UObject::FindClass(\"{}\");\n", GetCpp_xString(stru.FullName));
+    fmt::format_to(std::back_inserter(file), "\t\treturn ptr;\n");
+    fmt::format_to(std::back_inserter(file), "\t}}\n\n");
   };
 
-  auto GenerateProxyFunctionParamStruct = [](FILE* file, Function& func) {
+  // Members of the param struct in offset order, none when the signature could not be declared
+  auto SortedParams = [](const Function& func) {
+    std::vector<ParamInfo> params;
+    if (func.emptyParamStruct || func.badDeclareFunc) return params;
+    params = func.paramInfo;
+    std::sort(params.begin(), params.end(), [](const ParamInfo& a, const ParamInfo& b) {
+      return a.Offset < b.Offset;
+      });
+    return params;
+  };
+  auto GenerateProxyFunctionParamStruct = [](fmt::memory_buffer& file, const Function& func, const std::vector<ParamInfo>& params) {
     // ɺṹ
     if (func.FullName == "Dumper_Generated_Function") return;
-    static std::unordered_map<std::string, int> paramStructNameMp;
-
-    // ɵĽṹ
-    func.GeneratedParamName = GetValidClassName(func.FullName);
-    if (paramStructNameMp.count(func.GeneratedParamName)) {
-      func.GeneratedParamName = func.GeneratedParamName + fmt::format("_Param_{}", ++paramStructNameMp[func.GeneratedParamName]);
-    }
-    else {
-      paramStructNameMp[func.GeneratedParamName] = 1;
-      func.GeneratedParamName = func.GeneratedParamName + "_Param";
-    }
 
     // funcĲбƫȻɽṹ
-    std::sort(func.paramInfo.begin(), func.paramInfo.end(), [](const ParamInfo& a, const ParamInfo& b) {
-      return a.Offset < b.Offset;
-      });
     uint32 offset = 0;
     std::vector<Member> members;
-    auto replaceSubstr = [](std::string& originalStr, std::string substring, std::string replacement) {
-      size_t pos = 0;
-      const size_t substringLength = substring.length();
-      const size_t replacementLength = replacement.length();
-
-      while ((pos = originalStr.find(substring, pos)) != std::string::npos) {
-        originalStr.replace(pos, substringLength, replacement);
-        pos += replacementLength; // Move past the replaced substring
-      }
-    };
-    for (auto& param : func.paramInfo) {
+    for (auto& param : params) {
       assert(param.Size != 0);
       assert(param.Offset >= offset);
       if (param.Offset > offset) {
         Member padding;
-        padding.Type = "char";
-        padding.Name = fmt::format("pad_{:0X}[{:#0x}]", offset, param.Offset - offset);
+        padding.Type = TypeTable::Basic("char");
+        padding.Name = StringPool::Intern(fmt::format("pad_{:0X}[{:#0x}]", offset, param.Offset - offset));
         padding.Offset = offset;
         padding.Size = param.Offset - offset;
         members.push_back(padding);
@@ -1904,7 +2145,6 @@ void UE_UPackage::SavePackageCpp(FILE* cppFile, FILE* paramFile) {
       }
       Member mParam;
       mParam.Type = param.Type;
-      replaceSubstr(mParam.Type, "&", "");
       mParam.Name = param.Name;
       mParam.Offset = param.Offset;
       mParam.Size = param.Size;
@@ -1912,13 +2152,13 @@ void UE_UPackage::SavePackageCpp(FILE* cppFile, FILE* paramFile) {
       offset += mParam.Size;
       members.push_back(mParam);
     }
-    fmt::print(file, "\tstruct {}\n\t{{\n\tpublic:\n", func.GeneratedParamName);
+    fmt::format_to(std::back_inserter(file), "\tstruct {}\n\t{{\n\tpublic:\n", func.GeneratedParamName);
     for (auto& m : members) {
-      fmt::print(file, "\n\t\t{} {}; // {:#04x}({:#04x})", m.Type, m.Name, m.Offset, m.Size);
+      fmt::format_to(std::back_inserter(file), "\n\t\t{} {}; // {:#04x}({:#04x})", m.GetType(), StringPool::Get(m.Name), m.Offset, m.Size);
     }
-    fmt::print(file, "\n\t}};\n\n");
+    fmt::format_to(std::back_inserter(file), "\n\t}};\n\n");
   };
-  auto GenerateProxyFunctionBody = [&GenerateFunctionHeader](FILE* file, Function& func, Struct& stru) {
+  auto GenerateProxyFunctionBody = [&GenerateFunctionHeader](fmt::memory_buffer& file, Function& func, const std::vector<ParamInfo>& params, Struct& stru) {
     // ɺ
     if (func.FullName == "Dumper_Generated_Function") return;
     FunctionHeader header;
@@ -1927,37 +2167,37 @@ void UE_UPackage::SavePackageCpp(FILE* cppFile, FILE* paramFile) {
     GetFlagOutVector(func.FuncFlag, header.flags);
     GenerateFunctionHeader(file, header);
     std::string ProcessedFullName = GetCpp_xString(func.FullName);
-    fmt::print(file, "\t{} {}::{}({})\n\t{{\n", func.RetType, GetValidClassName(stru.ClassName), func.FuncName, func.Params);
-    fmt::print(file, "\t\tstatic UFunction* fn = nullptr;\n");
-    fmt::print(file, "\t\tif (!fn)\n");
-    fmt::print(file, "\t\t\tfn = UObject::FindObject<UFunction>(\"{}\");\n", ProcessedFullName);
-    fmt::print(file, "\t\t{} params {{ }};\n", func.GeneratedParamName);
-    for (auto& param : func.paramInfo) {
-      if (param.Name == "ReturnValue") continue;
-      fmt::print(file, "\t\tparams.{} = {};\n", param.Name, param.Name);
-    }
-    fmt::print(file, "\n\t\tauto flags = fn->FunctionFlags;\n");
+    fmt::format_to(std::back_inserter(file), "\t{} {}::{}({})\n\t{{\n", TypeTable::Render(func.RetType), GetValidClassName(stru.ClassName), func.FuncName, func.GetParams());
+    fmt::format_to(std::back_inserter(file), "\t\tstatic UFunction* fn = nullptr;\n");
+    fmt::format_to(std::back_inserter(file), "\t\tif (!fn)\n");
+    fmt::format_to(std::back_inserter(file), "\t\t\tfn = UObject::FindObject<UFunction>(\"{}\");\n", ProcessedFullName);
+    fmt::format_to(std::back_inserter(file), "\t\t{} params {{ }};\n", func.GeneratedParamName);
+    for (auto& param : params) {
+      if (param.isReturn) continue;
+      fmt::format_to(std::back_inserter(file), "\t\tparams.{0} = {0};\n", StringPool::Get(param.Name));
+    }
+    fmt::format_to(std::back_inserter(file), "\n\t\tauto flags = fn->FunctionFlags;\n");
     if (func.FuncFlag & FUNC_Native) {
-      fmt::print(file, "\t\tfn->FunctionFlags |= 0x00000400;\n");
+      fmt::format_to(std::back_inserter(file), "\t\tfn->FunctionFlags |= 0x00000400;\n");
     }
-    fmt::print(file, "\t\tUObject::ProcessEvent(fn, &params);\n");
-    fmt::print(file, "\t\tfn->FunctionFlags = flags;\n\n");
+    fmt::format_to(std::back_inserter(file), "\t\tUObject::ProcessEvent(fn, &params);\n");
+    fmt::format_to(std::back_inserter(file), "\t\tfn->FunctionFlags = flags;\n\n");
 
-    for (auto& param : func.paramInfo) {
-      if (param.Type[param.Type.size() - 1] == '&') {
-        fmt::print(file, "\t\t{} = params.{};\n", param.Name, param.Name);
+    for (auto& param : params) {
+      if (param.isOutRef) {
+        fmt::format_to(std::back_inserter(file), "\t\t{0} = params.{0};\n", StringPool::Get(param.Name));
       }
     }
 
-    if (func.RetType != "void") {
+    if (func.RetType != TypeTable::Void) {
       if (func.badDeclareFunc) {
-        fmt::print(file, "\t\treturn {{ }};  // BAD DECLARE FUNCTION!\n");
+        fmt::format_to(std::back_inserter(file), "\t\treturn {{ }};  // BAD DECLARE FUNCTION!\n");
       }
       else {
-        fmt::print(file, "\t\treturn params.ReturnValue;\n");
+        fmt::format_to(std::back_inserter(file), "\t\treturn params.ReturnValue;\n");
       }
     }
-    fmt::print(file, "\t}}\n");
+    fmt::format_to(std::back_inserter(file), "\t}}\n");
   };
   for (auto& stru : this->Structures) {
     GenerateStaticClass(cppFile, stru);
@@ -1968,23 +2208,25 @@ void UE_UPackage::SavePackageCpp(FILE* cppFile, FILE* paramFile) {
   // ʼɴ
   for (auto& stru : this->Structures) {
     for (auto& func : stru.Functions) {
-      GenerateProxyFunctionParamStruct(paramFile, func);
-      GenerateProxyFunctionBody(cppFile, func, stru);
+      auto params = SortedParams(func);
+      GenerateProxyFunctionParamStruct(paramFile, func, params);
+      GenerateProxyFunctionBody(cppFile, func, params, stru);
     }
   }
   for (auto& stru : this->Classes) {
     for (auto& func : stru.Functions) {
-      GenerateProxyFunctionParamStruct(paramFile, func);
-      GenerateProxyFunctionBody(cppFile, func, stru);
+      auto params = SortedParams(func);
+      GenerateProxyFunctionParamStruct(paramFile, func, params);
+      GenerateProxyFunctionBody(cppFile, func, params, stru);
     }
   }
 
-  fmt::print(cppFile, "}}");
-  fmt::print(paramFile, "}}");
+  fmt::format_to(std::back_inserter(cppFile), "}}");
+  fmt::format_to(std::back_inserter(paramFile), "}}");
   AddAlignDef(paramFile, 2);
 }
 
-bool UE_UPackage::Save(const fs::path &dir, bool spacing) {
+bool UE_UPackage::Save(const fs::path &dir, bool spacing, FileWriter& writer) {
   if (!(Classes.size() || Structures.size() || Enums.size())) {
     return false;
   }
@@ -1998,15 +2240,9 @@ bool UE_UPackage::Save(const fs::path &dir, bool spacing) {
       packageName[pos] = '_';
     }
   }
-  bool hasClassHeader = false;
-  bool hasStructHeader = false;
-
   if (Classes.size()) {
-    File file(dir / (packageName + "_classes.h"), "w");
-    hasClassHeader = true;
-    if (!file) {
-      return false;
-    }
+    fmt::memory_buffer file;
+    HasClassHeader = true;
     UE_UPackage::AddAlignDef(file, 1);
     UE_UPackage::AddNamespaceDef(file, 1);
     if (spacing) {
@@ -2016,14 +2252,12 @@ bool UE_UPackage::Save(const fs::path &dir, bool spacing) {
     }
     UE_UPackage::AddNamespaceDef(file, 2);
     UE_UPackage::AddAlignDef(file,2);
+    writer.Write(dir / (packageName + "_classes.h"), std::move(file));
   }
 
   if (Structures.size() || Enums.size()) {
-    File file(dir / (packageName + "_struct.h"), "w");
-    hasStructHeader = true;
-    if (!file) {
-      return false;
-    }
+    fmt::memory_buffer file;
+    HasStructHeader = true;
     UE_UPackage::AddAlignDef(file, 1);
     UE_UPackage::AddNamespaceDef(file, 1);
     if (Enums.size()) {
@@ -2039,17 +2273,15 @@ bool UE_UPackage::Save(const fs::path &dir, bool spacing) {
     }
     UE_UPackage::AddNamespaceDef(file, 2);
     UE_UPackage::AddAlignDef(file, 2);
-  }
-  {
-    // packageӦͷļ
-    File file(dir / (packageName + "_package.h"), "w");
-    UE_UPackage::SavePackageHeader(hasClassHeader, hasStructHeader, file);
+    writer.Write(dir / (packageName + "_struct.h"), std::move(file));
   }
   {
     // úcppļ
-    File cpp(dir / (packageName + "_package.cpp"), "w");
-    File param(dir / (packageName + "_param.h"), "w");
+    fmt::memory_buffer cpp;
+    fmt::memory_buffer param;
     UE_UPackage::SavePackageCpp(cpp, param);
+    writer.Write(dir / (packageName + "_package.cpp"), std::move(cpp));
+    writer.Write(dir / (packageName + "_param.h"), std::move(param));
   }
 
   return true;
@@ -1,12 +1,17 @@
 #pragma once
 #include "generic.h"
+#include "TypeRef.h"
+#include "StringPool.h"
+#include "FileWriter.h"
 #include <filesystem>
+#include <functional>
 #undef GetObject
 
 namespace fs = std::filesystem;
 
 class RefGraphSolver;
 class ClassSizeFixer;
+class PackageIR;
 
 // Wrapper for 'FILE*' that closes the file handle when it goes out of scope
 class File {
@@ -58,6 +63,8 @@ public:
   UE_FName(uint8 *object) : object(object) {}
   UE_FName() : object(nullptr) {}
   std::string GetName() const;
+  // Gets string for the already read FName fields
+  static std::string GetName(uint32 index, uint32 number);
 };
 
 class UE_UClass;
@@ -94,7 +101,8 @@ enum class PropertyType {
   MapProperty,
   InterfaceProperty,
   FieldPathProperty,
-  SoftClassProperty
+  SoftClassProperty,
+  LazyObjectProperty
 };
 
 class UE_UObject {
@@ -138,35 +146,15 @@ public:
   static UE_UClass StaticClass();
 };
 
-typedef std::pair<PropertyType, std::string> type;
+typedef std::pair<PropertyType, TypeRef> type;
 
-class IProperty {
-protected:
-  const void* prop;
-
-public:
-  IProperty(const void *object) : prop(object) {}
-  virtual std::string GetName() const = 0;
-  virtual int32 GetArrayDim() const = 0;
-  virtual int32 GetSize() const = 0;
-  virtual int32 GetOffset() const = 0;
-  virtual uint64 GetPropertyFlags() const = 0;
-  virtual type GetType() const = 0;
-  virtual uint8 GetFieldMask() const = 0;
-};
-
-class IUProperty : public IProperty {
-public:
-  using IProperty::IProperty;
-  IUProperty(const class UE_UProperty *object) : IProperty(object) {}
-  virtual std::string GetName() const;
-  virtual int32 GetArrayDim() const;
-  virtual int32 GetSize() const;
-  virtual int32 GetOffset() const;
-  virtual uint64 GetPropertyFlags() const;
-  virtual type GetType() const;
-  virtual uint8 GetFieldMask() const;
-};
+// Bytes after the base FProperty/UProperty fields holding what a reference-like property points at
+constexpr uint16 PropertyExtraSize = 16;
+// Object, class, soft, weak, lazy, interface and field path properties
+bool IsReferenceKind(PropertyType kind);
+// Type of a reference-like property from its already read extra fields, the class
+// and struct names come from ObjTable so nothing else is read from the game
+TypeRef ResolveReferenceType(PropertyType kind, const uint8* extra);
 
 class UE_UProperty : public UE_UField {
 public:
@@ -177,13 +165,13 @@ public:
   uint64 GetPropertyFlags() const;
   type GetType() const;
 
-  IUProperty GetInterface() const;
+  // Kind of a property class, resolved once per class
+  static PropertyType KindOf(UE_UClass cls);
   static UE_UClass StaticClass();
 };
 
 class UE_UStruct : public UE_UField {
 public:
-  uint32 FixedSize = 0;
   using UE_UField::UE_UField;
   UE_UStruct GetSuper() const;
   UE_FField GetChildProperties() const;
@@ -262,77 +250,77 @@ public:
 class UE_UDoubleProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UFloatProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UIntProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UInt16Property : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UInt64Property : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UInt8Property : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UUInt16Property : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UUInt32Property : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UUInt64Property : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UTextProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UStrProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
@@ -340,14 +328,14 @@ class UE_UStructProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
   UE_UStruct GetStruct() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UNameProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
@@ -355,7 +343,6 @@ class UE_UObjectPropertyBase : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
   UE_UClass GetPropertyClass() const;
-  std::string GetTypeStr() const;
   static UE_UClass StaticClass();
 };
 
@@ -363,7 +350,7 @@ class UE_UArrayProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
   UE_UProperty GetInner() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
@@ -371,7 +358,7 @@ class UE_UByteProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
   UE_UEnum GetEnum() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
@@ -379,7 +366,7 @@ class UE_UBoolProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
   uint8 GetFieldMask() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
@@ -387,7 +374,7 @@ class UE_UEnumProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
   UE_UClass GetEnum() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
@@ -395,7 +382,6 @@ class UE_UClassProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
   UE_UClass GetMetaClass() const;
-  std::string GetTypeStr() const;
   static UE_UClass StaticClass();
 };
 
@@ -403,7 +389,7 @@ class UE_USetProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
   UE_UProperty GetElementProp() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
@@ -412,32 +398,48 @@ public:
   using UE_UProperty::UE_UProperty;
   UE_UProperty GetKeyProp() const;
   UE_UProperty GetValueProp() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UInterfaceProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  UE_UProperty GetInterfaceClass() const;
-  std::string GetTypeStr() const;
+  UE_UClass GetInterfaceClass() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UMulticastDelegateProperty : public UE_UProperty {
 public:
   using UE_UProperty::UE_UProperty;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
   static UE_UClass StaticClass();
 };
 
 class UE_UWeakObjectProperty : public UE_UProperty {
   public:
     using UE_UProperty::UE_UProperty;
-    std::string GetTypeStr() const;
     static UE_UClass StaticClass();
 };
 
+class UE_ULazyObjectProperty : public UE_UProperty {
+public:
+  using UE_UProperty::UE_UProperty;
+  static UE_UClass StaticClass();
+};
+
+class UE_USoftObjectProperty : public UE_UProperty {
+public:
+  using UE_UProperty::UE_UProperty;
+  static UE_UClass StaticClass();
+};
+
+class UE_USoftClassProperty : public UE_USoftObjectProperty {
+public:
+  using UE_USoftObjectProperty::UE_USoftObjectProperty;
+  static UE_UClass StaticClass();
+};
+
 class UE_FFieldClass {
 protected:
   uint8 *object;
@@ -445,6 +447,7 @@ protected:
 public:
   UE_FFieldClass(uint8 *object) : object(object){};
   UE_FFieldClass() : object(nullptr){};
+  void* GetAddress() const { return object; }
   std::string GetName() const;
 };
 
@@ -455,6 +458,7 @@ protected:
 public:
   UE_FField(uint8 *object) : object(object) {}
   UE_FField() : object(nullptr) {}
+  void* GetAddress() const { return object; }
   operator bool() const { return object != nullptr; }
   UE_FField GetNext() const;
   std::string GetName() const;
@@ -462,18 +466,6 @@ public:
   template <typename Base> Base Cast() const { return Base(object); }
 };
 
-class IFProperty : public IProperty {
-public:
-  IFProperty(const class UE_FProperty *object) : IProperty(object) {}
-  virtual std::string GetName() const;
-  virtual int32 GetArrayDim() const;
-  virtual int32 GetSize() const;
-  virtual int32 GetOffset() const;
-  virtual uint64 GetPropertyFlags() const;
-  virtual type GetType() const;
-  virtual uint8 GetFieldMask() const;
-};
-
 
 
 class UE_FProperty : public UE_FField {
@@ -484,63 +476,63 @@ public:
   int32 GetOffset() const;
   uint64 GetPropertyFlags() const;
   type GetType() const;
-  IFProperty GetInterface() const;
+
+  // Kind of a property class, resolved once per class
+  static PropertyType KindOf(UE_FFieldClass cls);
 };
 
 class UE_FStructProperty : public UE_FProperty {
 public:
   using UE_FProperty::UE_FProperty;
   UE_UStruct GetStruct() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
 };
 
 class UE_FObjectPropertyBase : public UE_FProperty {
 public:
   using UE_FProperty::UE_FProperty;
   UE_UClass GetPropertyClass() const;
-  std::string GetTypeStr() const;
 };
 
 class UE_FArrayProperty : public UE_FProperty {
 public:
   using UE_FProperty::UE_FProperty;
   UE_FProperty GetInner() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
 };
 
 class UE_FByteProperty : public UE_FProperty {
 public:
   using UE_FProperty::UE_FProperty;
   UE_UEnum GetEnum() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
 };
 
 class UE_FBoolProperty : public UE_FProperty {
 public:
   using UE_FProperty::UE_FProperty;
   uint8 GetFieldMask() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
 };
 
 class UE_FEnumProperty : public UE_FProperty {
 public:
   using UE_FProperty::UE_FProperty;
   UE_UClass GetEnum() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
 };
 
 class UE_FClassProperty : public UE_FObjectPropertyBase {
 public:
   using UE_FObjectPropertyBase::UE_FObjectPropertyBase;
   UE_UClass GetMetaClass() const;
-  std::string GetTypeStr() const;
 };
 
 class UE_FSetProperty : public UE_FProperty {
 public:
   using UE_FProperty::UE_FProperty;
   UE_FProperty GetElementProp() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
 };
 
 class UE_FMapProperty : public UE_FProperty {
@@ -548,21 +540,19 @@ public:
   using UE_FProperty::UE_FProperty;
   UE_FProperty GetKeyProp() const;
   UE_FProperty GetValueProp() const;
-  std::string GetTypeStr() const;
+  TypeRef GetTypeRef() const;
 };
 
 class UE_FInterfaceProperty : public UE_FProperty {
 public:
   using UE_FProperty::UE_FProperty;
   UE_UClass GetInterfaceClass() const;
-  std::string GetTypeStr() const;
 };
 
 class UE_FFieldPathProperty : public UE_FProperty {
 public:
   using UE_FProperty::UE_FProperty;
   UE_FName GetPropertyName() const;
-  std::string GetTypeStr() const;
 };
 
 template <typename T> bool UE_UObject::IsA() const {
@@ -581,58 +571,83 @@ private:
       isSuspectMember = false;
     }
     bool isSuspectMember;
-    std::string Type;
-    std::string Name;
+    bool isStatic = false;
+    TypeRef Type = 0;
+    StringRef Name = 0;
     uint32 Offset = 0;
     uint32 Size = 0;
+    std::string GetType() const { return (isStatic ? "static " : "") + TypeTable::Render(Type); }
   };
   struct ParamInfo {
     uint32 Offset = 0;
     uint32 Size = 0;
-    std::string Name;
-    std::string Type;
-    uint64 flags;
+    StringRef Name = 0;
+    TypeRef Type = 0;
+    bool isOutRef = false; // passed as 'Type&'
+    bool isReturn = false; // ReturnValue, not part of the parameter list
+    uint64 flags = 0;
   };
+  // Signature of a function, the declaration text is only rendered when the SDK is saved
   struct Function {
-    std::vector<ParamInfo> paramInfo;
-    std::vector<std::string> ParamTypes;
-    uint32 FuncFlag;
+    std::vector<ParamInfo> paramInfo; // parameters and return value in declaration order
+    std::vector<TypeRef> ParamTypes;
+    uint32 FuncFlag = 0;
     std::string FuncName;
-    std::string RetType;
+    TypeRef RetType = 0;
     std::string FullName;
-    std::string CppName;
-    std::string Params;
-    std::string Flags;
+    StringRef Flags = 0;
     std::string GeneratedParamName;
-    std::string declareConst;
+    StringRef declareStatic = 0;
+    StringRef declareConst = 0;
     uint64 Func = 0;
-    bool badDeclareFunc = false;
+    bool badDeclareFunc = false;  // parameter list commented out
+    bool emptyParamStruct = false; // parameters are not passed through the param struct
+
+    // 'RetType Name' part of the declaration
+    std::string GetCppName() const;
+    // Parameter list of the declaration
+    std::string GetParams() const;
   };
   struct Struct {
+    int32 Index = -1; // ObjTable index
     std::string FullName;
     std::string CppName;
     std::string ClassName;
-    std::string SuperName;
+    StringRef SuperName = 0;
+    int32 SuperIndex = -1; // ObjTable index of the super, -1 without one
     uint32 Inherited = 0;
     uint32 Size = 0;
     std::vector<Member> Members;
     std::vector<Function> Functions;
   };
   struct Enum {
+    int32 Index = -1; // ObjTable index
     std::string FullName;
     std::string CppName;
     std::string EnumName;
     std::vector<std::string> Members;
   };
+  enum class DeclKind : uint8 { Class, Structure, Enum };
+  // Type the package defines, known before it is generated
+  struct Declaration {
+    int32 Index = -1; // ObjTable index
+    DeclKind Kind = DeclKind::Class;
+    std::string Name; // ClassName of classes and structures, EnumName of enums
+    bool DeclareOnly = false; // pointed to from a scoped dump, not generated
+  };
 
 private:
   std::pair<uint8 *const, std::vector<UE_UObject>> *Package;
+  std::vector<Declaration> Declarations;
   std::vector<Struct> Classes;
   std::vector<Struct> Structures;
   std::vector<Enum> Enums;
 public:
   std::string packageName;
   bool FindPointers = false;
+  // set by Save, the package header is written once the includes are known
+  bool HasClassHeader = false;
+  bool HasStructHeader = false;
 
 
 private:
@@ -644,22 +659,38 @@ private:
   static std::string ProcessUTF8Char(std::string input);
   static std::string GetCpp_xString(std::string& input);
   static std::string GetValidClassName(std::string str);
-  static void GenerateStruct(UE_UStruct object, std::vector<Struct>& arr, bool findPointers);
+  static void GenerateStruct(UE_UStruct object, const std::string& className, std::vector<Struct>& arr, bool findPointers);
   static void FixKeywordConflict(std::string& tocheck);
   static void GenerateEnum(UE_UEnum object, std::vector<Enum>& arr);
-  static void SaveStruct(std::vector<Struct> &arr, FILE *file);
-  static void SaveStructSpacing(std::vector<Struct> &arr, FILE* file); // save struct with spacing to members applied
-  static void SaveEnum(std::vector<Enum> &arr, FILE* file);
+  static void SaveStruct(std::vector<Struct> &arr, fmt::memory_buffer& file);
+  static void SaveStructSpacing(std::vector<Struct> &arr, fmt::memory_buffer& file); // save struct with spacing to members applied
+  static void SaveEnum(std::vector<Enum> &arr, fmt::memory_buffer& file);
 public:
   UE_UPackage(std::pair<uint8* const, std::vector<UE_UObject>>& package) : Package(&package){};
-  void Process();
-  static void AddAlignDef(FILE* file, int type);
-  static void AddNamespaceDef(FILE* file, int type);
-  void SavePackageHeader(bool hasClassHeader, bool hasStructHeader, FILE* file);
-  void SavePackageCpp(FILE* cppFile, FILE* paramFile);
-  bool Save(const fs::path& dir, bool spacing);
+  // Package read back from an IR, there is no game object behind it
+  UE_UPackage() : Package(nullptr){};
+  // Names the classes, structures and enums of every package in package order, suffixing
+  // names that collide across packages. Runs before generation, so the definitions of
+  // all packages are known while they are generated.
+  static void DeclareTypes(std::vector<UE_UPackage>& packages);
+  // Generates the declared types of all packages, one pool task per type. Packages are
+  // handed to onPackage in order as soon as they are complete.
+  static void Process(std::vector<UE_UPackage>& packages, const std::function<void(UE_UPackage&)>& onPackage);
+  // Names the param structs of the package, packages have to come in the order they are saved
+  static void ResolveParamStructNames(UE_UPackage& package, std::unordered_map<std::string, int>& paramStructNameMp);
+  // Frees the generated types once the package is saved
+  void Release();
+  static void AddAlignDef(fmt::memory_buffer& file, int type);
+  static void AddNamespaceDef(fmt::memory_buffer& file, int type);
+  void SavePackageCpp(fmt::memory_buffer& cppFile, fmt::memory_buffer& paramFile);
+  // Formats the files of the package and hands them to the writer, except for the package header
+  bool Save(const fs::path& dir, bool spacing, FileWriter& writer);
+  // Writes <package>_package.h: the headers of the packages it includes, declarations of
+  // the types it only points to and then its own headers. Returns false if it is unchanged.
+  bool SavePackageHeader(const fs::path& dir, const std::vector<std::string>& includes, const std::vector<std::string>& declares, FileWriter& writer);
   UE_UObject GetObject() const;
 
   friend RefGraphSolver;
   friend ClassSizeFixer;
+  friend PackageIR;
 };
@@ -0,0 +1,237 @@
+// Microbenchmark of the signature scanner against the byte-by-byte FindSignature it replaced
+// and against SSE2/AVX2 loops that look for the rarest byte in aligned blocks, which is
+// what kept the dumper on the memchr scan. Scans a synthetic 200 MB buffer of code-like
+// bytes for the engine signatures of engine.cpp.
+//
+// g++ -O2 -std=c++17 -I../include -I../Dumper SignatureScanBench.cpp ../Dumper/SignatureScan.cpp -o SignatureScanBench
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <immintrin.h>
+#include "SignatureScan.h"
+
+// FindSignature before the scanner
+static bool Compare(uint8* data, uint8* sig, uint32 size) {
+  for (uint32 i = 0; i < size; i++) {
+    if (data[i] != sig[i] && sig[i] != 0x00) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static uint8* FindSignature(void* start, void* end, const char* sig, uint32 size) {
+  for (uint8* it = (uint8*)start; it < (uint8*)end - size; it++) {
+    if (Compare(it, (uint8*)sig, size)) {
+      return it;
+    };
+  }
+  return 0;
+}
+
+// Signature and its mask (0xFF where the byte has to match), padded to a multiple of 32
+// for the masked vector compares
+struct PaddedPattern : SignaturePattern {
+  std::vector<uint8> bytes;
+  std::vector<uint8> mask;
+
+  PaddedPattern(const char* sig, uint32 size) : SignaturePattern(sig, size) {
+    uint32 padded = (size + 31) / 32 * 32;
+    bytes.assign(padded, 0);
+    mask.assign(padded, 0);
+    for (uint32 i = 0; i < size; i++) {
+      bytes[i] = Sig[i];
+      mask[i] = Sig[i] ? 0xFF : 0x00;
+    }
+  }
+};
+
+static uint32 LowestBit(uint64 bits) {
+  return __builtin_ctzll(bits);
+}
+
+// Candidates until the rarest byte of the next one is on a 64 byte boundary, so the
+// vector loops only do aligned loads
+static uint8* FindHead(const PaddedPattern& pattern, uint8*& it, uint8* last) {
+  auto aligned = (uint8*)(((uintptr_t)(it + pattern.First) + 63) & ~(uintptr_t)63) - pattern.First;
+  if (aligned > last) aligned = last;
+  for (; it < aligned; it++) {
+    if (it[pattern.First] == pattern.Sig[pattern.First] && pattern.Matches(it)) return it;
+  }
+  return nullptr;
+}
+
+static uint8* FindTail(const PaddedPattern& pattern, uint8* it, uint8* last) {
+  for (; it < last; it++) {
+    if (pattern.Matches(it)) return it;
+  }
+  return nullptr;
+}
+
+static bool MatchesSSE2(const PaddedPattern& pattern, const uint8* data, const uint8* end) {
+  // the padded compare would read past the end of the buffer
+  if (data + pattern.bytes.size() > end) return pattern.Matches(data);
+  auto zero = _mm_setzero_si128();
+  for (size_t i = 0; i < pattern.bytes.size(); i += 16) {
+    auto diff = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(data + i)), _mm_loadu_si128((const __m128i*)(pattern.bytes.data() + i)));
+    diff = _mm_and_si128(diff, _mm_loadu_si128((const __m128i*)(pattern.mask.data() + i)));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(diff, zero)) != 0xFFFF) return false;
+  }
+  return true;
+}
+
+static uint8* FindSSE2(const PaddedPattern& pattern, uint8* it, uint8* last, uint8* end) {
+  if (auto found = FindHead(pattern, it, last)) return found;
+  auto anchor = _mm_set1_epi8((char)pattern.Sig[pattern.First]);
+  auto second = pattern.Sig[pattern.Second];
+  // the rarest byte of all 64 candidates is in front of 'end' since it is inside the signature
+  for (; it + 64 <= last; it += 64) {
+    auto at = (const __m128i*)(it + pattern.First);
+    auto hits0 = _mm_cmpeq_epi8(_mm_load_si128(at), anchor);
+    auto hits1 = _mm_cmpeq_epi8(_mm_load_si128(at + 1), anchor);
+    auto hits2 = _mm_cmpeq_epi8(_mm_load_si128(at + 2), anchor);
+    auto hits3 = _mm_cmpeq_epi8(_mm_load_si128(at + 3), anchor);
+    auto any = _mm_or_si128(_mm_or_si128(hits0, hits1), _mm_or_si128(hits2, hits3));
+    if (!_mm_movemask_epi8(any)) continue;
+    uint64 bits = (uint64)(uint32)_mm_movemask_epi8(hits0) | (uint64)(uint32)_mm_movemask_epi8(hits1) << 16 |
+      (uint64)(uint32)_mm_movemask_epi8(hits2) << 32 | (uint64)(uint32)_mm_movemask_epi8(hits3) << 48;
+    for (; bits; bits &= bits - 1) {
+      auto candidate = it + LowestBit(bits);
+      if (candidate[pattern.Second] == second && MatchesSSE2(pattern, candidate, end)) return candidate;
+    }
+  }
+  return FindTail(pattern, it, last);
+}
+
+__attribute__((target("avx2"))) static bool MatchesAVX2(const PaddedPattern& pattern, const uint8* data, const uint8* end) {
+  if (data + pattern.bytes.size() > end) return pattern.Matches(data);
+  for (size_t i = 0; i < pattern.bytes.size(); i += 32) {
+    auto diff = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(data + i)), _mm256_loadu_si256((const __m256i*)(pattern.bytes.data() + i)));
+    diff = _mm256_and_si256(diff, _mm256_loadu_si256((const __m256i*)(pattern.mask.data() + i)));
+    if (!_mm256_testz_si256(diff, diff)) return false;
+  }
+  return true;
+}
+
+__attribute__((target("avx2"))) static uint8* FindAVX2(const PaddedPattern& pattern, uint8* it, uint8* last, uint8* end) {
+  if (auto found = FindHead(pattern, it, last)) return found;
+  auto anchor = _mm256_set1_epi8((char)pattern.Sig[pattern.First]);
+  auto second = pattern.Sig[pattern.Second];
+  for (; it + 128 <= last; it += 128) {
+    auto at = (const __m256i*)(it + pattern.First);
+    auto hits0 = _mm256_cmpeq_epi8(_mm256_load_si256(at), anchor);
+    auto hits1 = _mm256_cmpeq_epi8(_mm256_load_si256(at + 1), anchor);
+    auto hits2 = _mm256_cmpeq_epi8(_mm256_load_si256(at + 2), anchor);
+    auto hits3 = _mm256_cmpeq_epi8(_mm256_load_si256(at + 3), anchor);
+    auto any = _mm256_or_si256(_mm256_or_si256(hits0, hits1), _mm256_or_si256(hits2, hits3));
+    if (_mm256_testz_si256(any, any)) continue;
+    for (int half = 0; half < 2; half++) {
+      uint64 bits = half ? (uint64)(uint32)_mm256_movemask_epi8(hits2) | (uint64)(uint32)_mm256_movemask_epi8(hits3) << 32
+        : (uint64)(uint32)_mm256_movemask_epi8(hits0) | (uint64)(uint32)_mm256_movemask_epi8(hits1) << 32;
+      for (; bits; bits &= bits - 1) {
+        auto candidate = it + half * 64 + LowestBit(bits);
+        if (candidate[pattern.Second] == second && MatchesAVX2(pattern, candidate, end)) return candidate;
+      }
+    }
+  }
+  return FindTail(pattern, it, last);
+}
+
+enum class ScanLevel { Scalar, SSE2, AVX2 };
+
+static uint8* Scan(void* start, void* end, const char* sig, uint32 size, ScanLevel level) {
+  if (level == ScanLevel::Scalar) return ScanSignature(start, end, sig, size);
+  auto begin = (uint8*)start;
+  auto stop = (uint8*)end;
+  if (stop - begin <= (int64)size) return nullptr;
+  PaddedPattern pattern(sig, size);
+  if (pattern.First == size) return begin;
+  if (level == ScanLevel::AVX2) return FindAVX2(pattern, begin, stop - size, stop);
+  return FindSSE2(pattern, begin, stop - size, stop);
+}
+
+static uint64 state = 0x9E3779B97F4A7C15ull;
+
+static uint64 Random() {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+// Most bytes come from the opcodes, prefixes and operands that dominate x64 code,
+// so the anchors of the signatures show up about as often as they would in a game
+static void FillCode(std::vector<uint8>& code) {
+  static const uint8 common[] = { 0x00, 0x00, 0x00, 0xFF, 0xCC, 0x48, 0x48, 0x8B, 0x89, 0x0F, 0xE8, 0x24,
+    0x4C, 0x44, 0x85, 0x83, 0xC0, 0x8D, 0x74, 0x75, 0x01, 0x45, 0x41, 0x33, 0xC3, 0x90, 0x40, 0x20 };
+  for (auto& byte : code) {
+    auto r = Random();
+    byte = (r & 0xFF) < 160 ? common[(r >> 8) % sizeof(common)] : (uint8)(r >> 16);
+  }
+}
+
+struct Signature {
+  const char* name;
+  const char* sig;
+  uint32 size;
+  double at; // where a match is planted, as a fraction of the buffer, negative for none
+};
+
+int main() {
+  const Signature signatures[] = {
+    { "names (RogueCompany)", "\x48\x8D\x0D\x00\x00\x00\x00\xE8\x00\x00\x00\x00\xC6\x05\x00\x00\x00\x00\x01\x0F\x10\x03\x4C\x8D\x44\x24\x20\x48\x8B\xC8", 30, 0.93 },
+    { "objects (RogueCompany)", "\x48\x8B\x05\x00\x00\x00\x00\x48\x8B\x0C\xC8\x48\x8D\x04\xD1\xEB", 16, 0.71 },
+    { "names (DeadByDaylight)", "\x48\x8D\x35\x00\x00\x00\x00\xEB\x16", 9, 0.88 },
+    { "objects (Brickadia)", "\x48\x8B\x05\x00\x00\x00\x00\x48\x63\x8C\x24\xE0", 12, 0.55 },
+    { "decryptAnsi", "\xE8\x00\x00\x00\x00\x0F\xB7\x3F\x33\xF6\xC1\xEF\x06\x48\x89\x33\x48\x89\x73\x08\x85\xFF\x0F\x84\x00\x00\x00\x00\x40\x00\x00\x00\x00", 33, 0.97 },
+    { "missing", "\x48\x8D\x0D\x00\x00\x00\x00\xE8\x00\x00\x00\x00\xC6\x05\x00\x00\x00\x00\x01\x0F\x10\x03\x4C\x8D\x44\x24\x21", 27, -1 },
+  };
+
+  std::vector<uint8> code(200ull << 20);
+  FillCode(code);
+  for (auto& s : signatures) {
+    if (s.at < 0) continue;
+    auto offset = (size_t)(code.size() * s.at);
+    for (uint32 i = 0; i < s.size; i++) {
+      if (s.sig[i]) code[offset + i] = (uint8)s.sig[i];
+    }
+  }
+  auto start = code.data();
+  auto end = code.data() + code.size();
+
+  std::vector<std::pair<const char*, ScanLevel>> levels = { { "scalar", ScanLevel::Scalar }, { "sse2", ScanLevel::SSE2 } };
+  if (__builtin_cpu_supports("avx2")) levels.push_back({ "avx2", ScanLevel::AVX2 });
+
+  auto time = [](auto&& fn, uint8*& result) {
+    double best = 1e30;
+    for (int run = 0; run < 3; run++) {
+      auto begin = std::chrono::steady_clock::now();
+      result = fn();
+      std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+      if (elapsed.count() < best) best = elapsed.count();
+    }
+    return best;
+  };
+
+  bool mismatch = false;
+  printf("%-24s %-10s %10s %10s %8s\n", "signature", "scanner", "ms", "MB/s", "speedup");
+  for (auto& s : signatures) {
+    uint8* expected;
+    auto baseline = time([&] { return FindSignature(start, end, s.sig, s.size); }, expected);
+    auto scanned = (expected ? expected : end) - start;
+    printf("%-24s %-10s %10.2f %10.0f %8s\n", s.name, "baseline", baseline, scanned / 1048576.0 / (baseline / 1000), "1.00x");
+    for (auto& level : levels) {
+      uint8* result;
+      auto ms = time([&] { return Scan(start, end, s.sig, s.size, level.second); }, result);
+      printf("%-24s %-10s %10.2f %10.0f %7.2fx\n", s.name, level.first, ms, scanned / 1048576.0 / (ms / 1000), baseline / ms);
+      if (result != expected) {
+        printf("  [ERROR] %s found %p, baseline found %p\n", level.first, (void*)result, (void*)expected);
+        mismatch = true;
+      }
+    }
+  }
+  return mismatch ? 1 : 0;
+}